@@ -0,0 +1,253 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+// parallel_for / parallel_reduce / parallel_scan с выбором бэкенда через параметр шаблона:
+//   par::Serial        - последовательно
+//   par::OpenMP        - omp parallel for, schedule(static): непрерывные блоки, как у пула
+//   par::OpenMPRuntime - omp parallel for, schedule(runtime) для автотюнинга; расписание
+//                        задаётся omp_set_schedule (см. autotune.h), в libgomp по умолчанию dynamic,1
+//   par::ThreadPool    - постоянный пул std::thread, статическое разбиение на непрерывные блоки
+// Тело цикла - параметр шаблона и встраивается; виртуальных вызовов на итерацию нет.
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <omp.h>
+
+namespace par {
+
+struct Serial {};
+struct OpenMP {};
+struct OpenMPRuntime {};
+struct ThreadPool {};
+
+// число блоков на поток в parallel_reduce: запас для динамических расписаний
+constexpr size_t CHUNKS_PER_THREAD = 4;
+
+// Пул рабочих потоков, растёт до максимального запрошенного числа.
+// Вложенный run из задачи пула выполняется последовательно.
+class WorkerPool {
+public:
+    static WorkerPool& instance() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto& t : workers_) {
+            t.join();
+        }
+    }
+
+    // fn(tid) для tid из [0, nthreads); tid 0 выполняется вызывающим потоком
+    void run(int nthreads, const std::function<void(int)>& fn) {
+        if (nthreads <= 1 || in_worker()) {
+            for (int tid = 0; tid < nthreads; ++tid) {
+                fn(tid);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> run_lock(run_mutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (static_cast<int>(workers_.size()) < nthreads - 1) {
+            int id = static_cast<int>(workers_.size()) + 1;
+            workers_.emplace_back(&WorkerPool::worker_loop, this, id, generation_);
+        }
+        job_ = &fn;
+        active_ = nthreads;
+        pending_ = nthreads - 1;
+        ++generation_;
+        lock.unlock();
+        start_cv_.notify_all();
+
+        in_worker() = true;
+        fn(0);
+        in_worker() = false;
+
+        lock.lock();
+        done_cv_.wait(lock, [this] { return pending_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    WorkerPool() = default;
+
+    static bool& in_worker() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    void worker_loop(int id, size_t seen) {
+        in_worker() = true;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+            if (id >= active_) continue;
+
+            const std::function<void(int)>* job = job_;
+            lock.unlock();
+            (*job)(id);
+            lock.lock();
+            if (--pending_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(int)>* job_ = nullptr;
+    size_t generation_ = 0;
+    int active_ = 0;
+    int pending_ = 0;
+    bool stop_ = false;
+};
+
+// for_each(first, last, nthreads, fn): fn(i) для каждого i из [first, last)
+template<typename Backend>
+struct Executor;
+
+template<>
+struct Executor<Serial> {
+    template<typename Fn>
+    static void for_each(size_t first, size_t last, int, Fn&& fn) {
+        for (size_t i = first; i < last; ++i) {
+            fn(i);
+        }
+    }
+};
+
+template<>
+struct Executor<OpenMP> {
+    template<typename Fn>
+    static void for_each(size_t first, size_t last, int nthreads, Fn&& fn) {
+        #pragma omp parallel for num_threads(nthreads) schedule(static)
+        for (size_t i = first; i < last; ++i) {
+            fn(i);
+        }
+    }
+};
+
+template<>
+struct Executor<OpenMPRuntime> {
+    template<typename Fn>
+    static void for_each(size_t first, size_t last, int nthreads, Fn&& fn) {
+        #pragma omp parallel for num_threads(nthreads) schedule(runtime)
+        for (size_t i = first; i < last; ++i) {
+            fn(i);
+        }
+    }
+};
+
+template<>
+struct Executor<ThreadPool> {
+    template<typename Fn>
+    static void for_each(size_t first, size_t last, int nthreads, Fn&& fn) {
+        size_t n = last - first;
+        int nt = static_cast<int>(std::min<size_t>(n, std::max(nthreads, 1)));
+        if (nt == 0) return;
+
+        WorkerPool::instance().run(nt, [&](int tid) {
+            size_t lo = first + n * tid / nt;
+            size_t hi = first + n * (tid + 1) / nt;
+            for (size_t i = lo; i < hi; ++i) {
+                fn(i);
+            }
+        });
+    }
+};
+
+template<typename Backend, typename Body>
+void parallel_for(size_t first, size_t last, int nthreads, Body&& body) {
+    Executor<Backend>::for_each(first, last, nthreads, body);
+}
+
+// body(lo, hi) возвращает частичный результат для [lo, hi). Частичные результаты
+// блоков объединяются попарным деревом в порядке блоков, поэтому результат не
+// зависит от расписания и порядка завершения потоков.
+template<typename Backend, typename T, typename Body, typename Combine>
+T parallel_reduce(size_t first, size_t last, int nthreads, T identity,
+                  Body&& body, Combine&& combine) {
+    size_t n = last - first;
+    if (n == 0) return identity;
+
+    size_t nchunks = std::min<size_t>(n, std::max(nthreads, 1) * CHUNKS_PER_THREAD);
+    std::vector<T> partial(nchunks, identity);
+    Executor<Backend>::for_each(0, nchunks, nthreads, [&](size_t c) {
+        partial[c] = body(first + n * c / nchunks, first + n * (c + 1) / nchunks);
+    });
+
+    for (size_t step = 1; step < nchunks; step *= 2) {
+        for (size_t c = 0; c + step < nchunks; c += 2 * step) {
+            partial[c] = combine(partial[c], partial[c + step]);
+        }
+    }
+    return partial[0];
+}
+
+// Включающий префикс: out[i] = in[0] op ... op in[i]; out может совпадать с in.
+// Два прохода: сканы блоков, затем сдвиг блоков на префикс сумм предыдущих.
+template<typename Backend, typename T, typename Op>
+void parallel_scan(const T* in, T* out, size_t n, int nthreads, T identity, Op&& op) {
+    if (n == 0) return;
+
+    size_t nchunks = std::min<size_t>(n, std::max(nthreads, 1));
+    std::vector<T> offset(nchunks, identity);
+    auto bounds = [&](size_t c, size_t& lo, size_t& hi) {
+        lo = n * c / nchunks;
+        hi = n * (c + 1) / nchunks;
+    };
+
+    Executor<Backend>::for_each(0, nchunks, nthreads, [&](size_t c) {
+        size_t lo, hi;
+        bounds(c, lo, hi);
+        T acc = identity;
+        for (size_t i = lo; i < hi; ++i) {
+            acc = op(acc, in[i]);
+            out[i] = acc;
+        }
+        offset[c] = acc;
+    });
+
+    T carry = identity;
+    for (size_t c = 0; c < nchunks; ++c) {
+        T sum = offset[c];
+        offset[c] = carry;
+        carry = op(carry, sum);
+    }
+
+    Executor<Backend>::for_each(1, nchunks, nthreads, [&](size_t c) {
+        size_t lo, hi;
+        bounds(c, lo, hi);
+        for (size_t i = lo; i < hi; ++i) {
+            out[i] = op(offset[c], out[i]);
+        }
+    });
+}
+
+template<typename Backend>
+const char* backend_name();
+
+template<> inline const char* backend_name<Serial>() { return "serial"; }
+template<> inline const char* backend_name<OpenMP>() { return "OpenMP"; }
+template<> inline const char* backend_name<OpenMPRuntime>() { return "OpenMP (runtime schedule)"; }
+template<> inline const char* backend_name<ThreadPool>() { return "std::thread pool"; }
+
+} // namespace par
+
+#endif
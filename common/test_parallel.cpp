@@ -0,0 +1,116 @@
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "parallel.hpp"
+
+const size_t SIZES[] = {0, 1, 2, 7, 64, 1001};
+const int THREADS[] = {1, 2, 3, 4, 8, 16};
+const size_t FIRST = 5;   // начало диапазона не с нуля
+
+void check(bool condition, const std::string& backend, const std::string& what, size_t n, int nthreads) {
+    if (!condition) {
+        throw std::runtime_error(backend + ": " + what + " failed (n = " + std::to_string(n) +
+                                 ", threads = " + std::to_string(nthreads) + ")");
+    }
+}
+
+// каждый индекс посещается ровно один раз, в том числе при вложенном вызове
+template<typename Backend>
+void test_for(size_t n, int nthreads) {
+    std::vector<int> visits(n, 0);
+    par::parallel_for<Backend>(FIRST, FIRST + n, nthreads, [&](size_t i) {
+        visits[i - FIRST]++;
+    });
+    for (int v : visits) {
+        check(v == 1, par::backend_name<Backend>(), "parallel_for", n, nthreads);
+    }
+
+    std::vector<int> nested(n * 2, 0);
+    par::parallel_for<Backend>(0, n, nthreads, [&](size_t i) {
+        par::parallel_for<Backend>(0, 2, nthreads, [&](size_t j) {
+            nested[i * 2 + j]++;
+        });
+    });
+    for (int v : nested) {
+        check(v == 1, par::backend_name<Backend>(), "nested parallel_for", n, nthreads);
+    }
+}
+
+// Сумма точная, а объединение отрезков проверяет, что блоки покрывают
+// диапазон и объединяются по порядку.
+template<typename Backend>
+void test_reduce(size_t n, int nthreads) {
+    long sum = par::parallel_reduce<Backend>(FIRST, FIRST + n, nthreads, 0L,
+        [](size_t lo, size_t hi) {
+            long s = 0;
+            for (size_t i = lo; i < hi; i++) {
+                s += i;
+            }
+            return s;
+        },
+        [](long l, long r) { return l + r; });
+    long expected = n == 0 ? 0 : (long)n * (2 * FIRST + n - 1) / 2;
+    check(sum == expected, par::backend_name<Backend>(), "parallel_reduce sum", n, nthreads);
+
+    using span = std::pair<size_t, size_t>;
+    bool ordered = true;
+    span all = par::parallel_reduce<Backend>(FIRST, FIRST + n, nthreads, span(FIRST, FIRST),
+        [](size_t lo, size_t hi) { return span(lo, hi); },
+        [&](span l, span r) {
+            ordered = ordered && l.second == r.first;
+            return span(l.first, r.second);
+        });
+    check(ordered && all == span(FIRST, FIRST + n), par::backend_name<Backend>(),
+          "parallel_reduce order", n, nthreads);
+}
+
+// включающий префикс, в отдельный массив и на месте
+template<typename Backend>
+void test_scan(size_t n, int nthreads) {
+    std::vector<long> in(n), expected(n), out(n, -1);
+    long acc = 0;
+    for (size_t i = 0; i < n; i++) {
+        in[i] = (long)(i * 7 % 11) - 5;
+        acc += in[i];
+        expected[i] = acc;
+    }
+    auto plus = [](long l, long r) { return l + r; };
+
+    par::parallel_scan<Backend>(in.data(), out.data(), n, nthreads, 0L, plus);
+    check(out == expected, par::backend_name<Backend>(), "parallel_scan", n, nthreads);
+
+    par::parallel_scan<Backend>(in.data(), in.data(), n, nthreads, 0L, plus);
+    check(in == expected, par::backend_name<Backend>(), "in-place parallel_scan", n, nthreads);
+}
+
+template<typename Backend>
+void test_backend() {
+    int cases = 0;
+    for (size_t n : SIZES) {
+        for (int nthreads : THREADS) {
+            test_for<Backend>(n, nthreads);
+            test_reduce<Backend>(n, nthreads);
+            test_scan<Backend>(n, nthreads);
+            cases++;
+        }
+    }
+    std::cout << par::backend_name<Backend>() << " backend passed (" << cases << " cases)\n";
+}
+
+int main() {
+    try {
+        test_backend<par::Serial>();
+        test_backend<par::OpenMP>();
+        test_backend<par::OpenMPRuntime>();
+        test_backend<par::ThreadPool>();
+
+        std::cout << "\nAll tests passed successfully!\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTEST FAILED:\n" << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,308 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+// Автотюнинг OpenMP-циклов: вид расписания, размер порции, число потоков и привязка.
+// Ядра должны использовать schedule(runtime) и num_threads(cfg->nthreads).
+// Лучшая конфигурация для (машина, ядро, размер) хранится в файле кэша
+// (AUTOTUNE_CACHE или ./autotune.cache) и подхватывается при следующих запусках.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <omp.h>
+
+#define TUNE_LINE 256
+
+typedef enum {
+    BIND_NONE,     // без привязки, маска процесса
+    BIND_CLOSE,    // поток t -> t-й CPU в порядке сокетов, соседние потоки рядом
+    BIND_SPREAD    // потоки равномерно по CPU, упорядоченным по сокетам (physical_package_id)
+} tune_bind;
+
+typedef struct {
+    omp_sched_t kind;
+    int chunk;         // 0 - размер по умолчанию для kind
+    int nthreads;
+    tune_bind bind;
+} tune_config;
+
+// время одного прогона ядра с конфигурацией cfg (уже применённой)
+typedef double (*tune_bench)(const tune_config* cfg, void* ctx);
+
+static const char* tune_kind_name(omp_sched_t kind) {
+    switch (kind) {
+        case omp_sched_static:  return "static";
+        case omp_sched_dynamic: return "dynamic";
+        case omp_sched_guided:  return "guided";
+        default:                return "auto";
+    }
+}
+
+static const char* tune_bind_name(tune_bind bind) {
+    switch (bind) {
+        case BIND_CLOSE:  return "close";
+        case BIND_SPREAD: return "spread";
+        default:          return "none";
+    }
+}
+
+static tune_config tune_default(int nthreads) {
+    tune_config cfg = { omp_sched_static, 0, nthreads, BIND_NONE };
+    return cfg;
+}
+
+static void tune_describe(const tune_config* cfg, char* buf, size_t len) {
+    snprintf(buf, len, "%s,%d x%d %s", tune_kind_name(cfg->kind), cfg->chunk,
+             cfg->nthreads, tune_bind_name(cfg->bind));
+}
+
+// маска процесса до первой привязки и наибольшая привязанная команда
+static cpu_set_t tune_initial_mask;
+static int tune_mask_saved = 0;
+static int tune_pinned_threads = 0;
+
+static int tune_cpu_package(int cpu) {
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+    FILE* f = fopen(path, "r");
+    int package = 0;
+    if (f != NULL) {
+        if (fscanf(f, "%d", &package) != 1) package = 0;
+        fclose(f);
+    }
+    return package;
+}
+
+// CPU маски set по возрастанию (сокет, номер); нумерация CPU часто чередует сокеты
+static int tune_cpu_order(const cpu_set_t* set, int* order) {
+    int package[CPU_SETSIZE];
+    int n = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, set)) continue;
+        int p = tune_cpu_package(cpu);
+        int k = n++;
+        for (; k > 0 && package[k - 1] > p; k--) {
+            order[k] = order[k - 1];
+            package[k] = package[k - 1];
+        }
+        order[k] = cpu;
+        package[k] = p;
+    }
+    return n;
+}
+
+// Устанавливает расписание для schedule(runtime) и при cfg->bind != BIND_NONE
+// привязывает потоки команды размера cfg->nthreads. Пул потоков libgomp
+// переиспользуется, поэтому привязка сохраняется для последующих областей того же
+// размера. BIND_NONE снимает только привязку, поставленную здесь же, а при
+// OMP_PROC_BIND/OMP_PLACES маски потоков не трогаются вовсе.
+static void tune_apply(const tune_config* cfg) {
+    omp_set_schedule(cfg->kind, cfg->chunk);
+
+    if (omp_get_proc_bind() != omp_proc_bind_false) return;
+    if (cfg->bind == BIND_NONE && tune_pinned_threads == 0) return;
+
+    if (!tune_mask_saved) {
+        sched_getaffinity(0, sizeof(tune_initial_mask), &tune_initial_mask);
+        tune_mask_saved = 1;
+    }
+
+    int order[CPU_SETSIZE];
+    int ncpu = tune_cpu_order(&tune_initial_mask, order);
+    int team = cfg->nthreads;
+    if (cfg->bind == BIND_NONE) {
+        // снять привязку со всех потоков, которые могли её получить
+        team = tune_pinned_threads > team ? tune_pinned_threads : team;
+        tune_pinned_threads = 0;
+    } else if (team > tune_pinned_threads) {
+        tune_pinned_threads = team;
+    }
+
+    #pragma omp parallel num_threads(team)
+    {
+        cpu_set_t set = tune_initial_mask;
+        if (cfg->bind != BIND_NONE) {
+            int tid = omp_get_thread_num();
+            int nt = omp_get_num_threads();
+            int slot = cfg->bind == BIND_CLOSE ? tid % ncpu
+                                               : (int)((long)tid * ncpu / nt) % ncpu;
+            CPU_ZERO(&set);
+            CPU_SET(order[slot], &set);
+        }
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+}
+
+// Поток, созданный главным при действующей привязке, наследует маску одного CPU;
+// возвращает ему маску процесса.
+static inline void tune_unpin_thread(pthread_t thread) {
+    if (tune_pinned_threads > 0) {
+        pthread_setaffinity_np(thread, sizeof(tune_initial_mask), &tune_initial_mask);
+    }
+}
+
+static const char* tune_cache_path(void) {
+    const char* path = getenv("AUTOTUNE_CACHE");
+    return path ? path : "autotune.cache";
+}
+
+static void tune_machine_id(char* buf, size_t len) {
+    char host[64] = "unknown";
+    gethostname(host, sizeof(host) - 1);
+    snprintf(buf, len, "%s/%d", host, omp_get_num_procs());
+}
+
+static int tune_parse_kind(const char* s, omp_sched_t* kind) {
+    if (strcmp(s, "static") == 0)  { *kind = omp_sched_static;  return 1; }
+    if (strcmp(s, "dynamic") == 0) { *kind = omp_sched_dynamic; return 1; }
+    if (strcmp(s, "guided") == 0)  { *kind = omp_sched_guided;  return 1; }
+    return 0;
+}
+
+static int tune_parse_bind(const char* s, tune_bind* bind) {
+    if (strcmp(s, "none") == 0)   { *bind = BIND_NONE;   return 1; }
+    if (strcmp(s, "close") == 0)  { *bind = BIND_CLOSE;  return 1; }
+    if (strcmp(s, "spread") == 0) { *bind = BIND_SPREAD; return 1; }
+    return 0;
+}
+
+// строка кэша: <машина> <ядро> <размер> <kind> <chunk> <потоки> <bind> <время>
+static int tune_cache_load(const char* kernel, long size, tune_config* cfg) {
+    FILE* f = fopen(tune_cache_path(), "r");
+    if (f == NULL) return 0;
+
+    char machine[128], line[TUNE_LINE];
+    tune_machine_id(machine, sizeof(machine));
+
+    int found = 0;
+    while (!found && fgets(line, sizeof(line), f)) {
+        char m[128], k[64], kind[16], bind[16];
+        long sz;
+        int chunk, nthreads;
+        double time;
+        if (sscanf(line, "%127s %63s %ld %15s %d %d %15s %lf",
+                   m, k, &sz, kind, &chunk, &nthreads, bind, &time) != 8) {
+            continue;
+        }
+        if (strcmp(m, machine) == 0 && strcmp(k, kernel) == 0 && sz == size &&
+            tune_parse_kind(kind, &cfg->kind) && tune_parse_bind(bind, &cfg->bind)) {
+            cfg->chunk = chunk;
+            cfg->nthreads = nthreads;
+            found = 1;
+        }
+    }
+
+    fclose(f);
+    return found;
+}
+
+// перезаписывает кэш через временный файл, заменяя запись для (машина, ядро, размер)
+static void tune_cache_store(const char* kernel, long size, const tune_config* cfg, double time) {
+    const char* path = tune_cache_path();
+    char tmp_path[1024];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    FILE* out = fopen(tmp_path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "autotune: cannot write %s\n", tmp_path);
+        return;
+    }
+
+    char machine[128], line[TUNE_LINE];
+    tune_machine_id(machine, sizeof(machine));
+
+    FILE* in = fopen(path, "r");
+    if (in != NULL) {
+        while (fgets(line, sizeof(line), in)) {
+            char m[128], k[64];
+            long sz;
+            if (sscanf(line, "%127s %63s %ld", m, k, &sz) == 3 &&
+                strcmp(m, machine) == 0 && strcmp(k, kernel) == 0 && sz == size) {
+                continue;
+            }
+            fputs(line, out);
+        }
+        fclose(in);
+    }
+
+    fprintf(out, "%s %s %ld %s %d %d %s %.6f\n", machine, kernel, size,
+            tune_kind_name(cfg->kind), cfg->chunk, cfg->nthreads,
+            tune_bind_name(cfg->bind), time);
+    fclose(out);
+    rename(tmp_path, path);
+}
+
+static double tune_try(tune_bench bench, void* ctx, const tune_config* cfg) {
+    tune_apply(cfg);
+    return bench(cfg, ctx);
+}
+
+// Покоординатный поиск: число потоков при static, затем вид расписания и порция,
+// затем привязка. Около 25 прогонов вместо полного перебора.
+static tune_config tune_search(tune_bench bench, void* ctx, double* best_time) {
+    const omp_sched_t kinds[] = {omp_sched_static, omp_sched_dynamic, omp_sched_guided};
+    const int chunks[] = {0, 1, 8, 64, 512};
+    const tune_bind binds[] = {BIND_NONE, BIND_CLOSE, BIND_SPREAD};
+    int nprocs = omp_get_num_procs();
+
+    tune_config best = tune_default(1);
+    *best_time = tune_try(bench, ctx, &best);
+
+    for (int t = 2; ; t *= 2) {
+        tune_config cfg = tune_default(t < nprocs ? t : nprocs);
+        if (cfg.nthreads == best.nthreads) break;
+        double time = tune_try(bench, ctx, &cfg);
+        if (time < *best_time) {
+            *best_time = time;
+            best = cfg;
+        }
+        if (t >= nprocs) break;
+    }
+
+    for (int k = 0; k < 3; k++) {
+        for (int c = 0; c < 5; c++) {
+            tune_config cfg = best;
+            cfg.kind = kinds[k];
+            cfg.chunk = chunks[c];
+            double time = tune_try(bench, ctx, &cfg);
+            if (time < *best_time) {
+                *best_time = time;
+                best = cfg;
+            }
+        }
+    }
+
+    for (int i = 1; i < 3; i++) {
+        tune_config cfg = best;
+        cfg.bind = binds[i];
+        double time = tune_try(bench, ctx, &cfg);
+        if (time < *best_time) {
+            *best_time = time;
+            best = cfg;
+        }
+    }
+
+    return best;
+}
+
+// Конфигурация ядра: из кэша, либо поиском при force. Возвращает 0, если
+// конфигурации нет. Найденная конфигурация уже применена.
+static int tune_get(const char* kernel, long size, int force, tune_bench bench, void* ctx,
+                    tune_config* cfg) {
+    if (!force) {
+        if (!tune_cache_load(kernel, size, cfg)) return 0;
+        tune_apply(cfg);
+        return 1;
+    }
+
+    double time;
+    *cfg = tune_search(bench, ctx, &time);
+    tune_cache_store(kernel, size, cfg, time);
+    tune_apply(cfg);
+    return 1;
+}
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+// Асинхронные контрольные точки итерационного решателя: x, число итераций, невязка
+// и позиция решения в серии запусков (число потоков, метод, этап серии).
+// Решатель только копирует x в буфер (ckpt_offer), запись на диск выполняет фоновый
+// поток. Если предыдущая точка ещё пишется, новая пропускается - решатель не ждёт.
+// Файл пишется во временный и переименовывается, поэтому на диске всегда целая точка.
+// По завершении решения ckpt_finish пишет итоговую точку с done = 1.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define CKPT_MAGIC "SLVCKPT3"
+
+typedef struct {
+    int iter;
+    long double residual;
+    int threads;
+    int version;
+    int tuned;              // 0 - основная серия, 1 - настроенные конфигурации
+    int done;               // решение завершено, x - результат
+} ckpt_state;
+
+// заголовок файла, за ним n значений x
+typedef struct {
+    char magic[8];
+    long n;
+    ckpt_state state;
+} ckpt_header;
+
+typedef struct {
+    const char* path;
+    long n;
+    int every;              // период в итерациях
+    int base_iter;          // итераций до начала решения (при продолжении)
+
+    long double* snapshot;  // копия x для фонового потока
+    ckpt_state state;       // состояние снимка
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int pending;            // снимок ждёт записи или пишется
+    int stop;
+
+    int written, skipped, failed;
+} checkpointer;
+
+static int ckpt_write(const char* path, const long double* x, long n, const ckpt_state* state) {
+    char tmp_path[1024];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    FILE* f = fopen(tmp_path, "wb");
+    if (f == NULL) return 0;
+
+    ckpt_header h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CKPT_MAGIC, sizeof(h.magic));
+    h.n = n;
+    h.state = *state;
+
+    int ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+             fwrite(x, sizeof(long double), n, f) == (size_t)n &&
+             fflush(f) == 0 && fsync(fileno(f)) == 0;
+    ok = fclose(f) == 0 && ok;
+    return ok && rename(tmp_path, path) == 0;
+}
+
+// Читает точку в x. Возвращает 0, если файла нет или он от системы другого размера.
+// Поля позиции не проверяются - это делает вызывающий.
+static int ckpt_load(const char* path, long double* x, long n, ckpt_state* state) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return 0;
+
+    ckpt_header h;
+    int ok = fread(&h, sizeof(h), 1, f) == 1 &&
+             memcmp(h.magic, CKPT_MAGIC, sizeof(h.magic)) == 0 && h.n == n &&
+             fread(x, sizeof(long double), n, f) == (size_t)n;
+    fclose(f);
+
+    if (ok) {
+        *state = h.state;
+    }
+    return ok;
+}
+
+static void* ckpt_writer(void* arg) {
+    checkpointer* c = (checkpointer*)arg;
+    pthread_mutex_lock(&c->mutex);
+    for (;;) {
+        while (!c->pending && !c->stop) {
+            pthread_cond_wait(&c->cond, &c->mutex);
+        }
+        if (!c->pending) break;
+
+        // пока pending, решатель снимок не трогает
+        pthread_mutex_unlock(&c->mutex);
+        int ok = ckpt_write(c->path, c->snapshot, c->n, &c->state);
+        pthread_mutex_lock(&c->mutex);
+
+        if (ok) {
+            c->written++;
+        } else if (c->failed++ == 0) {
+            fprintf(stderr, "checkpoint: cannot write %s\n", c->path);
+        }
+        c->pending = 0;
+    }
+    pthread_mutex_unlock(&c->mutex);
+    return NULL;
+}
+
+static void ckpt_start(checkpointer* c, const char* path, long n, int every, int base_iter,
+                       int threads, int version, int tuned) {
+    memset(c, 0, sizeof(*c));
+    c->path = path;
+    c->n = n;
+    c->every = every;
+    c->base_iter = base_iter;
+    c->state.threads = threads;
+    c->state.version = version;
+    c->state.tuned = tuned;
+    c->snapshot = (long double*)malloc(n * sizeof(long double));
+    pthread_mutex_init(&c->mutex, NULL);
+    pthread_cond_init(&c->cond, NULL);
+    pthread_create(&c->thread, NULL, ckpt_writer, c);
+}
+
+// x после iter итераций решения, residual - его невязка. Вызывается на каждой
+// итерации; точка снимается раз в every итераций, если фоновый поток свободен.
+static void ckpt_offer(checkpointer* c, const long double* x, int iter, long double residual) {
+    if (c == NULL || c->every <= 0 || iter == 0 || iter % c->every != 0) return;
+
+    if (pthread_mutex_trylock(&c->mutex) != 0) {
+        c->skipped++;
+        return;
+    }
+    if (c->pending) {
+        c->skipped++;
+    } else {
+        memcpy(c->snapshot, x, c->n * sizeof(long double));
+        c->state.iter = c->base_iter + iter;
+        c->state.residual = residual;
+        c->pending = 1;
+        pthread_cond_signal(&c->cond);
+    }
+    pthread_mutex_unlock(&c->mutex);
+}
+
+// дожидается записи последней снятой точки и останавливает фоновый поток
+static void ckpt_stop(checkpointer* c) {
+    pthread_mutex_lock(&c->mutex);
+    c->stop = 1;
+    pthread_cond_signal(&c->cond);
+    pthread_mutex_unlock(&c->mutex);
+
+    pthread_join(c->thread, NULL);
+    pthread_cond_destroy(&c->cond);
+    pthread_mutex_destroy(&c->mutex);
+    free(c->snapshot);
+}
+
+// останавливает фоновый поток и синхронно пишет итоговую точку
+static void ckpt_finish(checkpointer* c, const long double* x, int iter, long double residual) {
+    ckpt_stop(c);
+    c->state.iter = c->base_iter + iter;
+    c->state.residual = residual;
+    c->state.done = 1;
+    if (ckpt_write(c->path, x, c->n, &c->state)) {
+        c->written++;
+    } else if (c->failed++ == 0) {
+        fprintf(stderr, "checkpoint: cannot write %s\n", c->path);
+    }
+}
+
+#endif
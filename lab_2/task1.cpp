@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include <time.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "autotune.h"
+#include "parallel.hpp"
+
+
+void print_system_info() {
+    printf("=== System Information ===\n");
+    
+    printf("\nCPU Info:\n");
+    int ret1 = system("lscpu | grep -E 'Model name|CPU\\(s\\)|Thread\\(s\\) per core|Core\\(s\\) per socket|Socket\\(s\\)|NUMA node\\(s\\)'");
+    (void)ret1;
+    
+    printf("\nServer Info:\n");
+    int ret2 = system("cat /sys/devices/virtual/dmi/id/product_name 2>/dev/null || echo 'Unknown'");
+    (void)ret2;
+    
+    printf("\nNUMA Info:\n");
+    int ret3 = system("numactl --hardware | grep -E 'available|node [0-9] free'");
+    (void)ret3;
+    
+    printf("\nOS Info:\n");
+    int ret4 = system("cat /etc/os-release | grep PRETTY_NAME");
+    (void)ret4;
+    
+    printf("\n=========================\n");
+}
+
+void *safe_malloc(size_t size) {
+    void* ptr = malloc(size);
+    if (ptr == NULL) {
+        fprintf(stderr, "error! memory could not be allocated");
+        abort();
+    }
+    return ptr;
+}
+
+template<typename Backend = par::OpenMP>
+void parallel_matrix_operation(int size, int nthreads, void (*row_operation)(int, int, double*, double*, double*), double* a, double* b, double* c) {
+    par::parallel_for<Backend>(0, size, nthreads, [&](size_t i) {
+        row_operation((int)i, size, a, b, c);
+    });
+}
+
+// иниц элементов матрицы
+void init_row(int i, int size, double* a, double* b, double* c) {
+    for (int j = 0; j < size; j++) {
+        a[i * size + j] = i + j;
+    }
+    c[i] = 0.0;
+}
+
+// умножение строки на вектор
+void matvec_row(int i, int size, double* a, double* b, double* c) {
+    c[i] = 0;
+    for (int j = 0; j < size; j++) {
+        c[i] += a[i * size + j] * b[j];
+    }
+}
+
+typedef struct {
+    int size;
+    double *a, *b, *c;
+} matvec_data;
+
+matvec_data create_matvec_data(int matrix_size, int nthreads) {
+    matvec_data d;
+    d.size = matrix_size;
+    d.a = (double*)safe_malloc(sizeof(*d.a) * matrix_size * matrix_size);
+    d.b = (double*)safe_malloc(sizeof(*d.b) * matrix_size);
+    d.c = (double*)safe_malloc(sizeof(*d.c) * matrix_size);
+
+    parallel_matrix_operation(matrix_size, nthreads, init_row, d.a, d.b, d.c);
+    
+    for (int j = 0; j < matrix_size; j++) {
+        d.b[j] = j;
+    }
+    return d;
+}
+
+void free_matvec_data(matvec_data* d) {
+    free(d->a); free(d->b); free(d->c);
+}
+
+template<typename Backend = par::OpenMPRuntime>
+double time_matvec(matvec_data* d, int nthreads, int repeats) {
+    double min_time = 1e10;
+    for (int i = 0; i < repeats; i++) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        
+        parallel_matrix_operation<Backend>(d->size, nthreads, matvec_row, d->a, d->b, d->c);
+        
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+        min_time = elapsed < min_time ? elapsed : min_time;
+    }
+    return min_time;
+}
+
+double benchmark_matrix_mult(int matrix_size, int nthreads) {
+    matvec_data d = create_matvec_data(matrix_size, nthreads);
+    double min_time = time_matvec(&d, nthreads, 5);
+    free_matvec_data(&d);
+    return min_time;
+}
+
+double tune_matvec_bench(const tune_config* cfg, void* ctx) {
+    return time_matvec((matvec_data*)ctx, cfg->nthreads, 3);
+}
+
+void compare_backends(matvec_data* d, const int* thread_counts, int num_tests) {
+    double serial_time = time_matvec<par::Serial>(d, 1, 5);
+    
+    printf("\nBackends (serial: %.4f sec)\n", serial_time);
+    printf("| Threads | OpenMP (sec) | Speedup | Pool (sec) | Speedup |\n");
+    printf("|---------|--------------|---------|------------|---------|\n");
+    
+    for (int i = 0; i < num_tests; i++) {
+        tune_config cfg = tune_default(thread_counts[i]);
+        tune_apply(&cfg);
+        double omp_time = time_matvec<par::OpenMP>(d, thread_counts[i], 5);
+        double pool_time = time_matvec<par::ThreadPool>(d, thread_counts[i], 5);
+        
+        printf("| %7d | %12.4f | %7.2f | %10.4f | %7.2f |\n", thread_counts[i],
+               omp_time, serial_time / omp_time, pool_time, serial_time / pool_time);
+    }
+}
+
+void run_scalability_test(int matrix_size, int force_tune) {
+    int thread_counts[] = {1, 2, 4, 7, 8, 16, 20, 40};
+    int num_tests = sizeof(thread_counts) / sizeof(thread_counts[0]);
+    
+    double base_time = 0.0;
+    
+    printf("\nMatrix size: %dx%d\n", matrix_size, matrix_size);
+    printf("| Threads | Time (sec) | Speedup |\n");
+    printf("|---------|------------|---------|\n");
+    
+    for (int i = 0; i < num_tests; i++) {
+        tune_config cfg = tune_default(thread_counts[i]);
+        tune_apply(&cfg);
+        double time = benchmark_matrix_mult(matrix_size, thread_counts[i]);
+        
+        if (thread_counts[i] == 1) {
+            base_time = time;
+        }
+        
+        printf("| %7d | %10.4f | %7.2f |\n", 
+               thread_counts[i], time, base_time / time);
+    }
+
+    matvec_data d = create_matvec_data(matrix_size, thread_counts[num_tests - 1]);
+    compare_backends(&d, thread_counts, num_tests);
+
+    tune_config cfg;
+    if (tune_get("matvec", matrix_size, force_tune, tune_matvec_bench, &d, &cfg)) {
+        char desc[64];
+        tune_describe(&cfg, desc, sizeof(desc));
+        double time = time_matvec(&d, cfg.nthreads, 5);
+        printf("Tuned (%s): %.4f sec, speedup %.2f\n", desc, time, base_time / time);
+    }
+    free_matvec_data(&d);
+}
+
+int main(int argc, char** argv) {
+    int force_tune = argc > 1 && strcmp(argv[1], "--autotune") == 0;
+
+    print_system_info();
+    
+    printf("\n=== Scalability Analysis ===\n");
+    
+    run_scalability_test(20000, force_tune);
+    run_scalability_test(40000, force_tune);
+    
+    return 0;
+}
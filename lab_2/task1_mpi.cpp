@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include <mpi.h>
+
+#include "parallel.hpp"
+
+#define REPEATS 5
+
+
+void print_system_info() {
+    printf("=== System Information ===\n");
+
+    int ret;
+    printf("\nCPU Info:\n");
+    ret = system("lscpu | grep -E 'Model name|CPU\\(s\\)|Thread\\(s\\) per core|Core\\(s\\) per socket|Socket\\(s\\)|NUMA node\\(s\\)'");
+    (void)ret;
+
+    printf("\nServer Info:\n");
+    ret = system("cat /sys/devices/virtual/dmi/id/product_name 2>/dev/null || echo 'Unknown'");
+    (void)ret;
+
+    printf("\nNUMA Info:\n");
+    ret = system("numactl --hardware | grep -E 'available|node [0-9] free'");
+    (void)ret;
+
+    printf("\nOS Info:\n");
+    ret = system("cat /etc/os-release | grep PRETTY_NAME");
+    (void)ret;
+
+    printf("\n=========================\n");
+}
+
+void *safe_malloc(size_t size) {
+    void* ptr = malloc(size);
+    if (ptr == NULL) {
+        fprintf(stderr, "error! memory could not be allocated");
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    return ptr;
+}
+
+// блок строк процесса: [first, first + count)
+typedef struct {
+    int rank, nranks;
+    int size;
+    int first, count;
+    int* counts;
+    int* displs;
+} row_block;
+
+row_block create_row_block(MPI_Comm comm, int size) {
+    row_block rb;
+    MPI_Comm_rank(comm, &rb.rank);
+    MPI_Comm_size(comm, &rb.nranks);
+    rb.size = size;
+    rb.counts = (int*)safe_malloc(rb.nranks * sizeof(int));
+    rb.displs = (int*)safe_malloc(rb.nranks * sizeof(int));
+    for (int r = 0; r < rb.nranks; r++) {
+        rb.displs[r] = (int)((long)size * r / rb.nranks);
+        rb.counts[r] = (int)((long)size * (r + 1) / rb.nranks) - rb.displs[r];
+    }
+    rb.first = rb.displs[rb.rank];
+    rb.count = rb.counts[rb.rank];
+    return rb;
+}
+
+void free_row_block(row_block* rb) {
+    free(rb->counts);
+    free(rb->displs);
+}
+
+// свои строки a (как в task1: a[i][j] = i + j) и весь b;
+// par::OpenMP статический - первое касание теми же потоками, что и в matvec
+void initialize(const row_block* rb, double* a, double* b, int threads) {
+    par::parallel_for<par::OpenMP>(0, rb->count, threads, [&](size_t i) {
+        size_t gi = rb->first + i;
+        for (int j = 0; j < rb->size; j++) {
+            a[i * rb->size + j] = gi + j;
+        }
+    });
+    for (int j = 0; j < rb->size; j++) {
+        b[j] = j;
+    }
+}
+
+// c_own = a_own * b, затем сборка полного c на всех процессах
+void matvec(const row_block* rb, const double* a, const double* b, double* c_own, double* c,
+            int threads) {
+    par::parallel_for<par::OpenMP>(0, rb->count, threads, [&](size_t i) {
+        double sum = 0.0;
+        for (int j = 0; j < rb->size; j++) {
+            sum += a[i * rb->size + j] * b[j];
+        }
+        c_own[i] = sum;
+    });
+    MPI_Allgatherv(c_own, rb->count, MPI_DOUBLE, c, rb->counts, rb->displs, MPI_DOUBLE,
+                   MPI_COMM_WORLD);
+}
+
+// c[i] = i * sum(j) + sum(j^2)
+double max_rel_error(const row_block* rb, const double* c) {
+    double n = rb->size;
+    double s1 = n * (n - 1) / 2;
+    double s2 = (n - 1) * n * (2 * n - 1) / 6;
+    double err = 0.0;
+    for (int i = 0; i < rb->size; i++) {
+        double exact = i * s1 + s2;
+        err = fmax(err, fabs(c[i] - exact) / exact);
+    }
+    return err;
+}
+
+// минимальное время REPEATS прогонов, по самому медленному процессу
+double benchmark_matvec(const row_block* rb, const double* a, const double* b, double* c_own,
+                        double* c, int threads) {
+    double min_time = 1e10;
+    for (int r = 0; r < REPEATS; r++) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        double start = MPI_Wtime();
+        matvec(rb, a, b, c_own, c, threads);
+        double local = MPI_Wtime() - start, time;
+        MPI_Allreduce(&local, &time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        min_time = time < min_time ? time : min_time;
+    }
+    return min_time;
+}
+
+void run_scalability_test(int matrix_size) {
+    int threads[] = {1, 2, 4, 8, 16, 20};
+    int num_tests = sizeof(threads)/sizeof(threads[0]);
+
+    row_block rb = create_row_block(MPI_COMM_WORLD, matrix_size);
+    double* a = (double*)safe_malloc(sizeof(double) * rb.count * matrix_size);
+    double* b = (double*)safe_malloc(sizeof(double) * matrix_size);
+    double* c_own = (double*)safe_malloc(sizeof(double) * (rb.count > 0 ? rb.count : 1));
+    double* c = (double*)safe_malloc(sizeof(double) * matrix_size);
+
+    initialize(&rb, a, b, threads[num_tests - 1]);
+
+    if (rb.rank == 0) {
+        printf("\nMatrix size: %dx%d, ranks: %d\n", matrix_size, matrix_size, rb.nranks);
+        printf("| Threads/rank | Time (sec) | Speedup |  Max error |\n");
+        printf("|--------------|------------|---------|------------|\n");
+    }
+
+    double base_time = 0.0;
+    for (int i = 0; i < num_tests; i++) {
+        double time = benchmark_matvec(&rb, a, b, c_own, c, threads[i]);
+        if (i == 0) {
+            base_time = time;
+        }
+        if (rb.rank == 0) {
+            printf("| %12d | %10.4f | %7.2f | %10.2e |\n", threads[i], time, base_time / time,
+                   max_rel_error(&rb, c));
+        }
+    }
+
+    free(a); free(b); free(c_own); free(c);
+    free_row_block(&rb);
+}
+
+int main(int argc, char** argv) {
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    // MPI вызывается только вне omp-областей, но процессы многопоточные
+    if (provided < MPI_THREAD_FUNNELED) {
+        if (rank == 0) {
+            fprintf(stderr, "MPI_THREAD_FUNNELED is not supported\n");
+        }
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    if (rank == 0) {
+        print_system_info();
+        printf("\n=== Scalability Analysis (MPI) ===\n");
+    }
+
+    run_scalability_test(20000);
+    run_scalability_test(40000);
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,609 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include <math.h>
+#include <time.h>
+#include <string.h>
+
+#include "autotune.h"
+#include "parallel.hpp"
+
+#define BATCH 1024
+#define IDLE_YIELDS 64
+#define IDLE_MAX_SLEEP_US 128
+
+
+void print_system_info() {
+    printf("=== System Information ===\n");
+    
+    int ret;
+    printf("\nCPU Info:\n");
+    ret = system("lscpu | grep -E 'Model name|CPU\\(s\\)|Thread\\(s\\) per core|Core\\(s\\) per socket|Socket\\(s\\)|NUMA node\\(s\\)'");
+    (void)ret;
+    
+    printf("\nServer Info:\n");
+    ret = system("cat /sys/devices/virtual/dmi/id/product_name 2>/dev/null || echo 'Unknown'");
+    (void)ret;
+    
+    printf("\nNUMA Info:\n");
+    ret = system("numactl --hardware | grep -E 'available|node [0-9] free'");
+    (void)ret;
+    
+    printf("\nOS Info:\n");
+    ret = system("cat /etc/os-release | grep PRETTY_NAME");
+    (void)ret;
+    
+    printf("\n=========================\n");
+}
+
+double f(double x) {
+    return sin(x);
+}
+
+// пакетная подынтегральная функция: y[i] = f(x[i]), i < n
+typedef void (*batch_func)(const double* x, double* y, int n);
+
+typedef struct {
+    const char* name;
+    batch_func eval;
+    double flops_per_eval;   // номинальная стоимость одного вычисления
+} integrand;
+
+typedef enum {
+    REDUCE_OMP,    // reduction(+:sum)
+    REDUCE_TREE    // попарное дерево по частичным суммам блоков (par::parallel_reduce)
+} reduce_mode;
+
+// округление к ближайшему целому без вызова libm, векторизуется
+static inline double round_nearest(double x) {
+    return (x + 0x1.8p52) - 0x1.8p52;
+}
+
+// sin без ветвлений: редукция Коди-Уэйта по pi/2 и полиномы cephes на [-pi/4, pi/4].
+// Погрешность до 2 ulp относительно sin из libm при |x| <= 1e6; относительно точного
+// значения до ~1.6 ulp при |x| <= 1e3 и до ~2.4 ulp при |x| <= 1e6 (потери в редукции).
+static inline double sin_simd(double x) {
+    double j = round_nearest(x * 0.63661977236758134308);
+    double r = ((x - j * 1.57079632673412561417e+00)
+                   - j * 6.07710050630396597660e-11)
+                   - j * 2.02226624879595063154e-21;
+    double z = r * r;
+
+    double s = 1.58962301576546568060e-10;
+    s = s * z - 2.50507477628578072866e-8;
+    s = s * z + 2.75573136213857245213e-6;
+    s = s * z - 1.98412698295895385996e-4;
+    s = s * z + 8.33333333332211858878e-3;
+    s = s * z - 1.66666666666666307295e-1;
+    s = r + r * z * s;
+
+    double c = -1.13585365213876817300e-11;
+    c = c * z + 2.08757008419747316778e-9;
+    c = c * z - 2.75573141792967388112e-7;
+    c = c * z + 2.48015872888517045348e-5;
+    c = c * z - 1.38888888888730564116e-3;
+    c = c * z + 4.16666666666665929218e-2;
+    c = 1.0 - 0.5 * z + z * z * c;
+
+    // номер квадранта j mod 4
+    double t = j * 0.25;
+    double fl = round_nearest(t);
+    fl = fl > t ? fl - 1.0 : fl;
+    double q = j - 4.0 * fl;
+
+    double v = (q == 1.0 || q == 3.0) ? c : s;
+    return q >= 2.0 ? -v : v;
+}
+
+void sin_batch(const double* x, double* y, int n) {
+    #pragma omp simd
+    for (int i = 0; i < n; i++) {
+        y[i] = sin_simd(x[i]);
+    }
+}
+
+const integrand SIN_INTEGRAND = { "sin", sin_batch, 30.0 };
+
+// негладкая функция: излом производной в x = 1
+void sqrt_abs_batch(const double* x, double* y, int n) {
+    #pragma omp simd
+    for (int i = 0; i < n; i++) {
+        y[i] = sqrt(fabs(x[i] - 1.0));
+    }
+}
+
+const integrand SQRT_ABS_INTEGRAND = { "sqrt(|x - 1|)", sqrt_abs_batch, 3.0 };
+
+// попарная сумма y[0..n), y используется как рабочий буфер
+static double pairwise_sum(double* y, int n) {
+    if (n == 0) return 0.0;
+    while (n > 1) {
+        int half = n / 2;
+        int off = n - half;
+        #pragma omp simd
+        for (int i = 0; i < half; i++) {
+            y[i] += y[off + i];
+        }
+        n = off;
+    }
+    return y[0];
+}
+
+// сумма Кэхэна: sum += v с накоплением погрешности в comp
+static inline void kahan_add(double* sum, double* comp, double v) {
+    double y = v - *comp;
+    double t = *sum + y;
+    *comp = (t - *sum) - y;
+    *sum = t;
+}
+
+double integrate_omp_atomic(double a, double b, int nsteps, int nthreads) {
+    double h = (b - a) / nsteps;
+    double sum = 0.0;
+    
+    #pragma omp parallel num_threads(nthreads)
+    {
+        double local_sum = 0.0;
+        #pragma omp for schedule(runtime)
+        for (int i = 0; i < nsteps; i++) {
+            double x = a + (i + 0.5) * h;
+            local_sum += f(x);
+        }
+        
+        #pragma omp atomic
+        sum += local_sum;
+    }
+    
+    return sum * h;
+}
+
+// сумма f по пакетам [first, last) с компенсацией
+static double integrate_batches(const integrand* fn, double a, double h, int nsteps,
+                                size_t first, size_t last) {
+    double xs[BATCH] __attribute__((aligned(64)));
+    double ys[BATCH] __attribute__((aligned(64)));
+    double sum = 0.0, comp = 0.0;
+
+    for (size_t blk = first; blk < last; blk++) {
+        int base = (int)blk * BATCH;
+        int n = nsteps - base < BATCH ? nsteps - base : BATCH;
+
+        #pragma omp simd
+        for (int i = 0; i < n; i++) {
+            xs[i] = a + ((double)(base + i) + 0.5) * h;
+        }
+        fn->eval(xs, ys, n);
+        kahan_add(&sum, &comp, pairwise_sum(ys, n));
+    }
+
+    return sum - comp;
+}
+
+// Частичные суммы блоков пакетов объединяются попарным деревом (par::parallel_reduce),
+// результат не зависит от порядка прихода потоков.
+template<typename Backend = par::OpenMPRuntime>
+double integrate_simd_tree(const integrand* fn, double a, double b, int nsteps, int nthreads) {
+    double h = (b - a) / nsteps;
+    int nbatches = (nsteps + BATCH - 1) / BATCH;
+
+    double sum = par::parallel_reduce<Backend>(0, nbatches, nthreads, 0.0,
+        [&](size_t first, size_t last) {
+            return integrate_batches(fn, a, h, nsteps, first, last);
+        },
+        [](double x, double y) { return x + y; });
+
+    return sum * h;
+}
+
+double integrate_simd(const integrand* fn, double a, double b, int nsteps, int nthreads,
+                      reduce_mode mode) {
+    if (mode == REDUCE_TREE) {
+        return integrate_simd_tree(fn, a, b, nsteps, nthreads);
+    }
+
+    double h = (b - a) / nsteps;
+    int nbatches = (nsteps + BATCH - 1) / BATCH;
+    double sum = 0.0;
+
+    #pragma omp parallel num_threads(nthreads) reduction(+:sum)
+    {
+        double local = 0.0, comp = 0.0;
+        #pragma omp for schedule(runtime) nowait
+        for (int blk = 0; blk < nbatches; blk++) {
+            kahan_add(&local, &comp, integrate_batches(fn, a, h, nsteps, blk, blk + 1));
+        }
+        sum += local - comp;
+    }
+
+    return sum * h;
+}
+
+// узлы и веса Гаусса-Кронрода (7, 15) из QUADPACK qk15
+static const double GK15_X[8] = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.000000000000000000000000000000000
+};
+static const double GK15_WK[8] = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+};
+// веса Гаусса для узлов GK15_X[1], GK15_X[3], GK15_X[5], GK15_X[7]
+static const double GK15_WG[4] = {
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+};
+
+// интеграл по [a, b] по Кронроду, в *err - оценка |K15 - G7|
+static double gk15(const integrand* fn, double a, double b, double* err) {
+    double c = 0.5 * (a + b);
+    double r = 0.5 * (b - a);
+    double xs[15], ys[15];
+
+    for (int k = 0; k < 7; k++) {
+        xs[2 * k] = c - r * GK15_X[k];
+        xs[2 * k + 1] = c + r * GK15_X[k];
+    }
+    xs[14] = c;
+    fn->eval(xs, ys, 15);
+
+    double kronrod = GK15_WK[7] * ys[14];
+    double gauss = GK15_WG[3] * ys[14];
+    for (int k = 0; k < 7; k++) {
+        double pair = ys[2 * k] + ys[2 * k + 1];
+        kronrod += GK15_WK[k] * pair;
+        if (k % 2 == 1) {
+            gauss += GK15_WG[k / 2] * pair;
+        }
+    }
+
+    *err = fabs((kronrod - gauss) * r);
+    return kronrod * r;
+}
+
+typedef struct {
+    double a, b;
+} interval;
+
+// дек отрезков потока: владелец работает с хвостом, воры забирают из головы
+typedef struct {
+    omp_lock_t lock;
+    interval* items;
+    int head, tail, cap;
+} __attribute__((aligned(64))) work_deque;
+
+static void deque_push(work_deque* dq, interval iv) {
+    omp_set_lock(&dq->lock);
+    if (dq->tail == dq->cap) {
+        if (dq->head > 0) {
+            memmove(dq->items, dq->items + dq->head, (dq->tail - dq->head) * sizeof(interval));
+            dq->tail -= dq->head;
+            dq->head = 0;
+        } else {
+            dq->cap *= 2;
+            dq->items = (interval*)realloc(dq->items, dq->cap * sizeof(interval));
+        }
+    }
+    dq->items[dq->tail++] = iv;
+    omp_unset_lock(&dq->lock);
+}
+
+static int deque_pop(work_deque* dq, interval* iv) {
+    int ok = 0;
+    omp_set_lock(&dq->lock);
+    if (dq->tail > dq->head) {
+        *iv = dq->items[--dq->tail];
+        ok = 1;
+    }
+    omp_unset_lock(&dq->lock);
+    return ok;
+}
+
+static int deque_steal(work_deque* dq, interval* iv) {
+    int ok = 0;
+    omp_set_lock(&dq->lock);
+    if (dq->tail > dq->head) {
+        *iv = dq->items[dq->head++];
+        ok = 1;
+    }
+    omp_unset_lock(&dq->lock);
+    return ok;
+}
+
+// ожидание работы: сначала уступаем процессор, при долгом простое спим
+// с экспоненциально растущей паузой до IDLE_MAX_SLEEP_US
+static void idle_backoff(int* idle) {
+    if (*idle < IDLE_YIELDS) {
+        sched_yield();
+    } else {
+        int shift = *idle - IDLE_YIELDS;
+        long us = shift < 7 && (1L << shift) < IDLE_MAX_SLEEP_US ? 1L << shift : IDLE_MAX_SLEEP_US;
+        struct timespec ts = { 0, us * 1000 };
+        nanosleep(&ts, NULL);
+    }
+    (*idle)++;
+}
+
+// адаптивная квадратура GK15 с допуском tol, распределённым пропорционально длине отрезка.
+// В *nevals возвращается число вычислений f.
+double integrate_adaptive(const integrand* fn, double a, double b, double tol, int nthreads,
+                          long* nevals) {
+    work_deque* deques = (work_deque*)aligned_alloc(64, nthreads * sizeof(work_deque));
+    for (int t = 0; t < nthreads; t++) {
+        omp_init_lock(&deques[t].lock);
+        deques[t].cap = 64;
+        deques[t].items = (interval*)malloc(deques[t].cap * sizeof(interval));
+        deques[t].head = deques[t].tail = 0;
+    }
+
+    // число отрезков в деках и в обработке; 0 - работа закончена
+    long pending = 0;
+    double sum = 0.0;
+    long evals = 0;
+    double density = tol / (b - a);
+    double min_len = (b - a) * 1e-15;
+
+    #pragma omp parallel num_threads(nthreads) reduction(+:sum, evals)
+    {
+        int tid = omp_get_thread_num();
+        int nt = omp_get_num_threads();
+
+        #pragma omp single
+        {
+            for (int t = 0; t < nt; t++) {
+                interval iv = { a + (b - a) * t / nt, a + (b - a) * (t + 1) / nt };
+                deque_push(&deques[t], iv);
+            }
+            pending = nt;
+        }
+
+        double comp = 0.0;
+        interval iv;
+        int idle = 0;
+
+        for (;;) {
+            int found = deque_pop(&deques[tid], &iv);
+            for (int k = 1; !found && k < nt; k++) {
+                found = deque_steal(&deques[(tid + k) % nt], &iv);
+            }
+            if (!found) {
+                long left;
+                #pragma omp atomic read
+                left = pending;
+                if (left == 0) break;
+                idle_backoff(&idle);
+                continue;
+            }
+            idle = 0;
+
+            // левую половину обрабатываем сами, правую выставляем на кражу
+            for (;;) {
+                double err;
+                double value = gk15(fn, iv.a, iv.b, &err);
+                evals += 15;
+
+                double len = iv.b - iv.a;
+                if (err <= density * len || len < min_len) {
+                    kahan_add(&sum, &comp, value);
+                    break;
+                }
+
+                double mid = 0.5 * (iv.a + iv.b);
+                interval right = { mid, iv.b };
+                #pragma omp atomic
+                pending++;
+                deque_push(&deques[tid], right);
+                iv.b = mid;
+            }
+
+            #pragma omp atomic
+            pending--;
+        }
+
+        sum -= comp;
+    }
+
+    for (int t = 0; t < nthreads; t++) {
+        omp_destroy_lock(&deques[t].lock);
+        free(deques[t].items);
+    }
+    free(deques);
+
+    *nevals = evals;
+    return sum;
+}
+
+typedef enum {
+    METHOD_ATOMIC,
+    METHOD_SIMD_REDUCTION,
+    METHOD_SIMD_TREE
+} method;
+
+const char* method_name(method m) {
+    switch (m) {
+        case METHOD_ATOMIC:         return "omp atomic";
+        case METHOD_SIMD_REDUCTION: return "simd + omp reduction";
+        case METHOD_SIMD_TREE:      return "simd + tree reduction";
+    }
+    return "unknown";
+}
+
+double run_method(method m, double a, double b, int nsteps, int nthreads) {
+    switch (m) {
+        case METHOD_ATOMIC:
+            return integrate_omp_atomic(a, b, nsteps, nthreads);
+        case METHOD_SIMD_REDUCTION:
+            return integrate_simd(&SIN_INTEGRAND, a, b, nsteps, nthreads, REDUCE_OMP);
+        case METHOD_SIMD_TREE:
+            return integrate_simd(&SIN_INTEGRAND, a, b, nsteps, nthreads, REDUCE_TREE);
+    }
+    return 0.0;
+}
+
+double measure_performance(method m, double a, double b, int nsteps, int nthreads,
+                           double* result) {
+    double min_time = 1e10;
+    
+    for (int i = 0; i < 5; i++) {
+        double start = omp_get_wtime();
+        *result = run_method(m, a, b, nsteps, nthreads);
+        double end = omp_get_wtime();
+        min_time = (end - start < min_time) ? (end - start) : min_time;
+    }
+    
+    return min_time;
+}
+
+typedef struct {
+    method m;
+    double a, b;
+    int nsteps;
+} integrate_task;
+
+double tune_integrate_bench(const tune_config* cfg, void* ctx) {
+    integrate_task* t = (integrate_task*)ctx;
+    double result;
+    return measure_performance(t->m, t->a, t->b, t->nsteps, cfg->nthreads, &result);
+}
+
+int main(int argc, char** argv) {
+    int force_tune = argc > 1 && strcmp(argv[1], "--autotune") == 0;
+
+    print_system_info();
+    
+    const double a = 0.0;
+    const double b = M_PI;
+    const int nsteps = 40000000;
+    const int threads[] = {1, 2, 4, 7, 8, 16, 20, 40};
+    const int num_threads = sizeof(threads)/sizeof(threads[0]);
+    
+    double reference = -cos(b) - (-cos(a));
+    printf("\nReference value: %.15f\n", reference);
+    
+    tune_config sanity_cfg = tune_default(1);
+    tune_apply(&sanity_cfg);
+    double test_result = integrate_omp_atomic(a, b, 1000, 1);
+    printf("Sanity check (1000 steps): %.15f (error: %e)\n", 
+           test_result, fabs(test_result - (-cos(b) - (-cos(a)))));
+    test_result = integrate_simd(&SIN_INTEGRAND, a, b, 1000, 1, REDUCE_TREE);
+    printf("Sanity check simd (1000 steps): %.15f (error: %e)\n", 
+           test_result, fabs(test_result - reference));
+    
+    // середина отрезка (2) + накопление (1) + стоимость f
+    double flops = (double)nsteps * (SIN_INTEGRAND.flops_per_eval + 3.0);
+    const method methods[] = {METHOD_ATOMIC, METHOD_SIMD_REDUCTION, METHOD_SIMD_TREE};
+    const char* kernels[] = {"integrate_atomic", "integrate_simd_reduction", "integrate_simd_tree"};
+    const int num_methods = sizeof(methods)/sizeof(methods[0]);
+    
+    for (int k = 0; k < num_methods; k++) {
+        printf("\n=== Performance Analysis: %s ===\n", method_name(methods[k]));
+        printf("| Threads | Time (s) | Speedup | GFLOP/s |   Error   |\n");
+        printf("|---------|----------|---------|---------|-----------|\n");
+        
+        double base_time = 0.0;
+        for (int i = 0; i < num_threads; i++) {
+            double result;
+            tune_config cfg = tune_default(threads[i]);
+            tune_apply(&cfg);
+            double time = measure_performance(methods[k], a, b, nsteps, threads[i], &result);
+            
+            if (threads[i] == 1) {
+                base_time = time;
+            }
+            
+            printf("| %7d | %8.4f | %7.2f | %7.2f | %9.2e |\n", 
+                   threads[i], time, base_time / time, flops / time / 1e9,
+                   fabs(result - reference));
+        }
+        
+        integrate_task task = { methods[k], a, b, nsteps };
+        tune_config cfg;
+        if (tune_get(kernels[k], nsteps, force_tune, tune_integrate_bench, &task, &cfg)) {
+            char desc[64];
+            double result;
+            tune_describe(&cfg, desc, sizeof(desc));
+            double time = measure_performance(methods[k], a, b, nsteps, cfg.nthreads, &result);
+            printf("Tuned (%s): %.4f s, speedup %.2f, %.2f GFLOP/s\n",
+                   desc, time, base_time / time, flops / time / 1e9);
+        }
+    }
+    
+    double serial_time = 1e10;
+    for (int rep = 0; rep < 5; rep++) {
+        double start = omp_get_wtime();
+        integrate_simd_tree<par::Serial>(&SIN_INTEGRAND, a, b, nsteps, 1);
+        double end = omp_get_wtime();
+        serial_time = (end - start < serial_time) ? (end - start) : serial_time;
+    }
+    
+    printf("\n=== Backends: simd + tree reduction (serial: %.4f s) ===\n", serial_time);
+    printf("| Threads | OpenMP (s) | Speedup | Pool (s) | Speedup |\n");
+    printf("|---------|------------|---------|----------|---------|\n");
+    
+    for (int i = 0; i < num_threads; i++) {
+        double omp_time = 1e10, pool_time = 1e10;
+        tune_config cfg = tune_default(threads[i]);
+        tune_apply(&cfg);
+        
+        for (int rep = 0; rep < 5; rep++) {
+            double start = omp_get_wtime();
+            integrate_simd_tree<par::OpenMP>(&SIN_INTEGRAND, a, b, nsteps, threads[i]);
+            double mid = omp_get_wtime();
+            integrate_simd_tree<par::ThreadPool>(&SIN_INTEGRAND, a, b, nsteps, threads[i]);
+            double end = omp_get_wtime();
+            omp_time = (mid - start < omp_time) ? (mid - start) : omp_time;
+            pool_time = (end - mid < pool_time) ? (end - mid) : pool_time;
+        }
+        
+        printf("| %7d | %10.4f | %7.2f | %8.4f | %7.2f |\n", threads[i],
+               omp_time, serial_time / omp_time, pool_time, serial_time / pool_time);
+    }
+    
+    // время достижения точности: адаптивный метод с допуском, равным ошибке
+    // фиксированной сетки nsteps
+    const integrand* fns[] = {&SIN_INTEGRAND, &SQRT_ABS_INTEGRAND};
+    const double refs[] = {
+        reference,
+        2.0 / 3.0 * (pow(1.0 - a, 1.5) + pow(b - 1.0, 1.5))
+    };
+    
+    for (int k = 0; k < 2; k++) {
+        printf("\n=== Time to accuracy: %s ===\n", fns[k]->name);
+        printf("| Threads | Fixed (s) | Fixed evals |   Error   | Adaptive (s) | Adaptive evals |   Error   | Speedup |\n");
+        printf("|---------|-----------|-------------|-----------|--------------|----------------|-----------|---------|\n");
+        
+        for (int i = 0; i < num_threads; i++) {
+            double fixed_time = 1e10, adaptive_time = 1e10;
+            double fixed_result = 0.0, adaptive_result = 0.0;
+            long nevals = 0;
+            tune_config cfg = tune_default(threads[i]);
+            tune_apply(&cfg);
+            
+            for (int rep = 0; rep < 5; rep++) {
+                double start = omp_get_wtime();
+                fixed_result = integrate_simd(fns[k], a, b, nsteps, threads[i], REDUCE_TREE);
+                double end = omp_get_wtime();
+                fixed_time = (end - start < fixed_time) ? (end - start) : fixed_time;
+            }
+            double fixed_error = fabs(fixed_result - refs[k]);
+            double tol = fixed_error > 1e-14 ? fixed_error : 1e-14;
+            
+            for (int rep = 0; rep < 5; rep++) {
+                double start = omp_get_wtime();
+                adaptive_result = integrate_adaptive(fns[k], a, b, tol, threads[i], &nevals);
+                double end = omp_get_wtime();
+                adaptive_time = (end - start < adaptive_time) ? (end - start) : adaptive_time;
+            }
+            
+            printf("| %7d | %9.4f | %11d | %9.2e | %12.6f | %14ld | %9.2e | %7.1f |\n",
+                   threads[i], fixed_time, nsteps, fixed_error,
+                   adaptive_time, nevals, fabs(adaptive_result - refs[k]),
+                   fixed_time / adaptive_time);
+        }
+    }
+    
+    return 0;
+}
\ No newline at end of file
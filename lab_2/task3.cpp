@@ -5,10 +5,16 @@
 #include <time.h>
 #include <string.h>
 
+#include "autotune.h"
+#include "checkpoint.h"
+#include "parallel.hpp"
+
 #define MATRIX_SIZE 10000
 #define MAX_ITER 10000
 #define EPSILON 1e-5
 #define ITERATION_STEP (1.0/100000.0)
+#define TUNE_ITER 20
+#define CKPT_EVERY 10
 
 
 void print_system_info() {
@@ -42,58 +48,67 @@ long double* create_matrix() {
     return (long double*)aligned_alloc(64, MATRIX_SIZE * MATRIX_SIZE * sizeof(long double));
 }
 
-void initialize(long double* A, long double* b, long double* x) {
-    #pragma omp parallel for
-    for (size_t i = 0; i < MATRIX_SIZE; i++) {
+template<typename Backend = par::OpenMP>
+void initialize(long double* A, long double* b, long double* x, int threads) {
+    par::parallel_for<Backend>(0, MATRIX_SIZE, threads, [&](size_t i) {
         b[i] = MATRIX_SIZE + 1.0;
         x[i] = 0.0;
         for (size_t j = 0; j < MATRIX_SIZE; j++) {
             A[i * MATRIX_SIZE + j] = (i == j) ? 2.0 : 1.0;
         }
-    }
+    });
 }
 
-long double vector_norm(const long double* v) {
-    long double norm = 0.0;
-    #pragma omp parallel for reduction(+:norm)
-    for (size_t i = 0; i < MATRIX_SIZE; i++) {
-        norm += v[i] * v[i];
-    }
+template<typename Backend = par::OpenMP>
+long double vector_norm(const long double* v, int threads) {
+    long double norm = par::parallel_reduce<Backend>(0, MATRIX_SIZE, threads, 0.0L,
+        [&](size_t lo, size_t hi) {
+            long double sum = 0.0;
+            for (size_t i = lo; i < hi; i++) {
+                sum += v[i] * v[i];
+            }
+            return sum;
+        },
+        [](long double l, long double r) { return l + r; });
     return sqrtl(norm);
 }
 
-void solve_system(long double* A, long double* b, long double* x, int threads, int version) {
+// Метод 1 выполняется на бэкенде Backend, метод 2 - только OpenMP.
+// x - начальное приближение. Если ckpt не NULL, x периодически сохраняется.
+// Возвращает число итераций, в *residual - относительную невязку.
+template<typename Backend = par::OpenMPRuntime>
+int solve_system(long double* A, long double* b, long double* x, int threads, int version,
+                 int max_iter, long double* residual, checkpointer* ckpt = NULL) {
     long double* tmp = create_vector();
-    long double b_norm = vector_norm(b);
+    long double b_norm = vector_norm<Backend>(b, threads);
     long double rel_residual;
     int iter = 0;
     
     if (version == 1) {
         // Метод 1: Отдельные parallel for
         do {
-            #pragma omp parallel for num_threads(threads)
-            for (size_t i = 0; i < MATRIX_SIZE; i++) {
+            par::parallel_for<Backend>(0, MATRIX_SIZE, threads, [&](size_t i) {
                 tmp[i] = -b[i];
                 for (size_t j = 0; j < MATRIX_SIZE; j++) {
                     tmp[i] += A[i * MATRIX_SIZE + j] * x[j];
                 }
-            }
+            });
             
-            rel_residual = vector_norm(tmp) / b_norm;
+            rel_residual = vector_norm<Backend>(tmp, threads) / b_norm;
+            ckpt_offer(ckpt, x, iter, rel_residual);
             
-            #pragma omp parallel for num_threads(threads)
-            for (size_t i = 0; i < MATRIX_SIZE; i++) {
+            par::parallel_for<Backend>(0, MATRIX_SIZE, threads, [&](size_t i) {
                 x[i] -= ITERATION_STEP * tmp[i];
-            }
+            });
             
             iter++;
-        } while (rel_residual > EPSILON && iter < MAX_ITER);
+        } while (rel_residual > EPSILON && iter < max_iter);
     } else {
         // Метод 2: Единая parallel секция
         #pragma omp parallel num_threads(threads)
         {
-            while (iter < MAX_ITER) {
-                #pragma omp for
+            while (iter < max_iter) {
+                #pragma omp for schedule(runtime)
                 for (size_t i = 0; i < MATRIX_SIZE; i++) {
                     tmp[i] = -b[i];
                     for (size_t j = 0; j < MATRIX_SIZE; j++) {
@@ -103,13 +118,14 @@ void solve_system(long double* A, long double* b, long double* x, int threads, i
                 
                 #pragma omp single
                 {
-                    rel_residual = vector_norm(tmp) / b_norm;
+                    rel_residual = vector_norm<par::Serial>(tmp, 1) / b_norm;
+                    ckpt_offer(ckpt, x, iter, rel_residual);
                     iter++;
                 }
                 
                 if (rel_residual <= EPSILON) break;
                 
-                #pragma omp for
+                #pragma omp for schedule(runtime)
                 for (size_t i = 0; i < MATRIX_SIZE; i++) {
                     x[i] -= ITERATION_STEP * tmp[i];
                 }
@@ -117,43 +133,248 @@ void solve_system(long double* A, long double* b, long double* x, int threads, i
         }
     }
     
-    printf("Method %d: %d iterations, residual: %.3Le\n", version, iter, rel_residual);
     free(tmp);
+    *residual = rel_residual;
+    return iter;
 }
 
 void check_solution(const long double* x) {
-    long double error = 0.0;
-    #pragma omp parallel for reduction(+:error)
-    for (size_t i = 0; i < MATRIX_SIZE; i++) {
-        error += fabsl(x[i] - 1.0L);
-    }
+    long double error = par::parallel_reduce<par::OpenMP>(0, MATRIX_SIZE, omp_get_max_threads(), 0.0L,
+        [&](size_t lo, size_t hi) {
+            long double sum = 0.0;
+            for (size_t i = lo; i < hi; i++) {
+                sum += fabsl(x[i] - 1.0L);
+            }
+            return sum;
+        },
+        [](long double l, long double r) { return l + r; });
     printf("Average error: %.3Le\n", error/MATRIX_SIZE);
 }
 
-int main() {
+typedef struct {
+    long double *A, *b, *x;
+    int version;
+} solve_task;
+
+// TUNE_ITER итераций вместо полного решения
+template<typename Backend = par::OpenMPRuntime>
+double time_short_solve(long double* A, long double* b, long double* x, int threads, int version) {
+    long double residual;
+    memset(x, 0, MATRIX_SIZE * sizeof(long double));
+    double start = omp_get_wtime();
+    solve_system<Backend>(A, b, x, threads, version, TUNE_ITER, &residual);
+    return omp_get_wtime() - start;
+}
+
+double tune_solve_bench(const tune_config* cfg, void* ctx) {
+    solve_task* t = (solve_task*)ctx;
+    return time_short_solve(t->A, t->b, t->x, cfg->nthreads, t->version);
+}
+
+typedef struct {
+    const char* ckpt_path;  // NULL - без контрольных точек
+    int ckpt_every;
+    long double* resume_x;  // x прерванного решения, NULL - нет
+    int resume_iter;
+    long double* prev;      // последнее решение для --warm, NULL - старт с нуля
+    int have_prev;
+} solve_options;
+
+// Позиция продолжения серии threads[0..num_tests) из контрольной точки; индекс
+// num_tests - настроенные конфигурации. Прерванное решение продолжается с
+// сохранённого x, после завершённого серия начинается со следующего.
+void load_resume_point(solve_options* opt, const int* threads, int num_tests,
+                       int* threads_index, int* version) {
+    long double* x = create_vector();
+    ckpt_state st;
+    if (!ckpt_load(opt->ckpt_path, x, MATRIX_SIZE, &st)) {
+        printf("\nNo checkpoint in %s, starting from the beginning\n", opt->ckpt_path);
+        free(x);
+        return;
+    }
+
+    int index = num_tests;
+    const char* reason = NULL;
+    if (st.version != 1 && st.version != 2) {
+        reason = "method is not 1 or 2";
+    } else if (st.iter < 0 || (st.tuned != 0 && st.tuned != 1)) {
+        reason = "corrupted header";
+    } else if (!st.tuned) {
+        for (index = 0; index < num_tests && threads[index] != st.threads; index++) {}
+        if (index == num_tests) {
+            reason = "thread count is not in this sweep";
+        }
+    }
+    if (reason != NULL) {
+        printf("\nCheckpoint %s rejected (%s: threads %d, method %d), starting from the beginning\n",
+               opt->ckpt_path, reason, st.threads, st.version);
+        free(x);
+        return;
+    }
+
+    printf("\nResumed from %s: %s, threads %d, method %d, iteration %d, residual: %.3Le%s\n",
+           opt->ckpt_path, st.tuned ? "tuned" : "sweep", st.threads, st.version, st.iter,
+           st.residual, st.done ? " (finished)" : "");
+
+    *threads_index = index;
+    *version = st.version;
+    if (!st.done) {
+        opt->resume_x = x;
+        opt->resume_iter = st.iter;
+        return;
+    }
+    if (++*version > 2) {
+        *version = 1;
+        ++*threads_index;
+    }
+    if (opt->prev != NULL) {
+        memcpy(opt->prev, x, MATRIX_SIZE * sizeof(long double));
+        opt->have_prev = 1;
+    }
+    free(x);
+}
+
+// начальное приближение: контрольная точка, предыдущее решение или ноль;
+// возвращает число уже выполненных итераций
+int initial_guess(long double* x, solve_options* opt) {
+    if (opt->resume_x != NULL) {
+        memcpy(x, opt->resume_x, MATRIX_SIZE * sizeof(long double));
+        free(opt->resume_x);
+        opt->resume_x = NULL;
+        return opt->resume_iter;
+    }
+    if (opt->prev != NULL && opt->have_prev) {
+        memcpy(x, opt->prev, MATRIX_SIZE * sizeof(long double));
+        return 0;
+    }
+    memset(x, 0, MATRIX_SIZE * sizeof(long double));
+    return 0;
+}
+
+// threads, version и tuned - позиция в серии, записывается в контрольные точки
+void run_solve(long double* A, long double* b, long double* x, int threads, int version,
+               int tuned, solve_options* opt) {
+    long double residual;
+    int done = initial_guess(x, opt);
+    int max_iter = done < MAX_ITER ? MAX_ITER - done : 1;
+
+    checkpointer ckpt;
+    if (opt->ckpt_path != NULL) {
+        ckpt_start(&ckpt, opt->ckpt_path, MATRIX_SIZE, opt->ckpt_every, done, threads, version, tuned);
+        tune_unpin_thread(ckpt.thread);
+    }
+    
+    double start = omp_get_wtime();
+    int iter = solve_system(A, b, x, threads, version, max_iter, &residual,
+                            opt->ckpt_path != NULL ? &ckpt : NULL);
+    double time = omp_get_wtime() - start;
+    
+    printf("Method %d: %d iterations, residual: %.3Le\n", version, done + iter, residual);
+    printf("Time: %.3f sec\n", time);
+    if (opt->ckpt_path != NULL) {
+        ckpt_finish(&ckpt, x, iter, residual);
+        printf("Checkpoints: %d written, %d skipped\n", ckpt.written, ckpt.skipped);
+    }
+    check_solution(x);
+    
+    if (opt->prev != NULL) {
+        memcpy(opt->prev, x, MATRIX_SIZE * sizeof(long double));
+        opt->have_prev = 1;
+    }
+}
+
+// --autotune              поиск конфигурации вместо кэша
+// --checkpoint FILE       контрольные точки каждые CKPT_EVERY итераций
+// --checkpoint-every N    период контрольных точек в итерациях
+// --resume                серия продолжается с позиции и x из FILE
+// --warm                  каждое решение начинается с предыдущего x (время не сравнимо с холодным стартом)
+int main(int argc, char** argv) {
+    int force_tune = 0, warm = 0, resume = 0;
+    solve_options opt = { NULL, CKPT_EVERY, NULL, 0, NULL, 0 };
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--autotune") == 0) {
+            force_tune = 1;
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            opt.ckpt_path = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            opt.ckpt_every = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--resume") == 0) {
+            resume = 1;
+        } else if (strcmp(argv[i], "--warm") == 0) {
+            warm = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [--autotune] [--checkpoint FILE [--checkpoint-every N] [--resume]] [--warm]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (resume && opt.ckpt_path == NULL) {
+        fprintf(stderr, "--resume requires --checkpoint FILE\n");
+        return 1;
+    }
+
     print_system_info();
     
     long double* A = create_matrix();
     long double* b = create_vector();
     long double* x = create_vector();
+    if (warm) {
+        opt.prev = create_vector();
+    }
     
-    initialize(A, b, x);
+    initialize(A, b, x, omp_get_max_threads());
     
     int threads[] = {1, 2, 4, 8, 16, 32, 40};
     int num_tests = sizeof(threads)/sizeof(threads[0]);
     
-    for (int i = 0; i < num_tests; i++) {
+    // позиция в серии; индекс num_tests - настроенные конфигурации
+    int start_index = 0, start_version = 1;
+    if (resume) {
+        load_resume_point(&opt, threads, num_tests, &start_index, &start_version);
+    }
+    
+    for (int i = start_index; i < num_tests; i++) {
         printf("\nThreads: %d\n", threads[i]);
+        tune_config cfg = tune_default(threads[i]);
+        tune_apply(&cfg);
+        
+        for (int version = i == start_index ? start_version : 1; version <= 2; version++) {
+            run_solve(A, b, x, threads[i], version, 0, &opt);
+        }
+    }
+    
+    // метод 1 на всех бэкендах; при продолжении после серии уже выведено
+    if (start_index < num_tests) {
+        double serial_time = time_short_solve<par::Serial>(A, b, x, 1, 1);
+        printf("\nBackends, method 1, %d iterations (serial: %.3f sec)\n", TUNE_ITER, serial_time);
+        printf("| Threads | OpenMP (sec) | Speedup | Pool (sec) | Speedup |\n");
+        printf("|---------|--------------|---------|------------|---------|\n");
+        
+        for (int i = 0; i < num_tests; i++) {
+            tune_config cfg = tune_default(threads[i]);
+            tune_apply(&cfg);
+            double omp_time = time_short_solve<par::OpenMP>(A, b, x, threads[i], 1);
+            double pool_time = time_short_solve<par::ThreadPool>(A, b, x, threads[i], 1);
+        
+            printf("| %7d | %12.3f | %7.2f | %10.3f | %7.2f |\n", threads[i],
+                   omp_time, serial_time / omp_time, pool_time, serial_time / pool_time);
+        }
+    }
         
-        for (int version = 1; version <= 2; version++) {
-            memset(x, 0, MATRIX_SIZE * sizeof(long double));
-            double start = omp_get_wtime();
-            solve_system(A, b, x, threads[i], version);
-            printf("Time: %.3f sec\n", omp_get_wtime() - start);
-            check_solution(x);
+    const char* kernels[] = {"solve_v1", "solve_v2"};
+    for (int version = start_index == num_tests ? start_version : 1;
+         start_index <= num_tests && version <= 2; version++) {
+        solve_task task = { A, b, x, version };
+        tune_config cfg;
+        if (tune_get(kernels[version - 1], MATRIX_SIZE, force_tune, tune_solve_bench, &task, &cfg)) {
+            char desc[64];
+            tune_describe(&cfg, desc, sizeof(desc));
+            printf("\nTuned (%s)\n", desc);
+            run_solve(A, b, x, cfg.nthreads, version, 1, &opt);
         }
     }
     
     free(A); free(b); free(x);
+    free(opt.prev);
+    free(opt.resume_x);
     return 0;
 }
\ No newline at end of file
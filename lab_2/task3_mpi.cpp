@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include <string.h>
+#include <mpi.h>
+
+#include "parallel.hpp"
+
+#define MATRIX_SIZE 10000
+#define MAX_ITER 10000
+#define EPSILON 1e-5
+#define ITERATION_STEP (1.0/100000.0)
+#define TEST_EVERY 64
+
+
+void print_system_info() {
+    printf("=== System Information ===\n");
+
+    int ret;
+    printf("\nCPU Info:\n");
+    ret = system("lscpu | grep -E 'Model name|CPU\\(s\\)|Thread\\(s\\) per core|Core\\(s\\) per socket|Socket\\(s\\)|NUMA node\\(s\\)'");
+    (void)ret;
+
+    printf("\nServer Info:\n");
+    ret = system("cat /sys/devices/virtual/dmi/id/product_name 2>/dev/null || echo 'Unknown'");
+    (void)ret;
+
+    printf("\nNUMA Info:\n");
+    ret = system("numactl --hardware | grep -E 'available|node [0-9] free'");
+    (void)ret;
+
+    printf("\nOS Info:\n");
+    ret = system("cat /etc/os-release | grep PRETTY_NAME");
+    (void)ret;
+
+    printf("\n=========================\n");
+}
+
+// блок строк процесса: [first, first + count)
+typedef struct {
+    int rank, nranks;
+    int first, count;
+    int* counts;
+    int* displs;
+    int funneled;   // MPI_THREAD_FUNNELED: главный поток может вызывать MPI внутри omp-областей
+} row_block;
+
+row_block create_row_block(MPI_Comm comm) {
+    row_block rb;
+    MPI_Comm_rank(comm, &rb.rank);
+    MPI_Comm_size(comm, &rb.nranks);
+    rb.counts = (int*)malloc(rb.nranks * sizeof(int));
+    rb.displs = (int*)malloc(rb.nranks * sizeof(int));
+    for (int r = 0; r < rb.nranks; r++) {
+        rb.displs[r] = (int)((long)MATRIX_SIZE * r / rb.nranks);
+        rb.counts[r] = (int)((long)MATRIX_SIZE * (r + 1) / rb.nranks) - rb.displs[r];
+    }
+    rb.funneled = 0;
+    rb.first = rb.displs[rb.rank];
+    rb.count = rb.counts[rb.rank];
+    return rb;
+}
+
+void free_row_block(row_block* rb) {
+    free(rb->counts);
+    free(rb->displs);
+}
+
+long double* create_vector(size_t n) {
+    return (long double*)aligned_alloc(64, n * sizeof(long double));
+}
+
+// свои строки A и b; первое касание потоками процесса - память на его NUMA-узле
+void initialize(const row_block* rb, long double* A, long double* b, int threads) {
+    par::parallel_for<par::OpenMP>(0, rb->count, threads, [&](size_t i) {
+        size_t gi = rb->first + i;
+        b[i] = MATRIX_SIZE + 1.0;
+        for (size_t j = 0; j < MATRIX_SIZE; j++) {
+            A[i * MATRIX_SIZE + j] = (gi == j) ? 2.0 : 1.0;
+        }
+    });
+}
+
+long double local_sq_norm(const long double* v, int n, int threads) {
+    return par::parallel_reduce<par::OpenMP>(0, n, threads, 0.0L,
+        [&](size_t lo, size_t hi) {
+            long double sum = 0.0;
+            for (size_t i = lo; i < hi; i++) {
+                sum += v[i] * v[i];
+            }
+            return sum;
+        },
+        [](long double l, long double r) { return l + r; });
+}
+
+// tmp[i] += A[i, lo..hi) * x[lo..hi) для своих строк; x хранится со смещения x_base
+void matvec_columns(const row_block* rb, const long double* A, const long double* x, size_t x_base,
+                    long double* tmp, size_t lo, size_t hi, int threads, MPI_Request* pending) {
+    par::parallel_for<par::OpenMP>(0, rb->count, threads, [&](size_t i) {
+        long double sum = 0.0;
+        for (size_t j = lo; j < hi; j++) {
+            sum += A[i * MATRIX_SIZE + j] * x[j - x_base];
+        }
+        tmp[i] += sum;
+
+        // продвижение неблокирующего обмена (MPI_THREAD_FUNNELED: только главный поток,
+        // поэтому бэкенд - OpenMP, где главный поток работает в команде)
+        if (pending != NULL && omp_get_thread_num() == 0 && i % TEST_EVERY == 0) {
+            int done;
+            MPI_Test(pending, &done, MPI_STATUS_IGNORE);
+        }
+    });
+}
+
+// Метод простой итерации для строк, распределённых по процессам.
+// x - полный вектор, одинаковый на всех процессах. Обмен x (Iallgatherv) и
+// редукция невязки (Iallreduce) перекрываются с вычислениями: пока собирается
+// новый x, считается вклад диагонального блока, пока суммируется невязка -
+// обновляется свой блок x.
+int solve_system(const row_block* rb, const long double* A, const long double* b,
+                 long double* x, int threads, int max_iter, long double* residual) {
+    long double* tmp = create_vector(rb->count);
+    long double* x_own[2] = { create_vector(rb->count), create_vector(rb->count) };
+    long double* x_full[2] = { x, create_vector(MATRIX_SIZE) };
+    memcpy(x_own[0], x + rb->first, rb->count * sizeof(long double));
+
+    long double b_norm = 0.0;
+    long double b_local = local_sq_norm(b, rb->count, threads);
+    MPI_Allreduce(&b_local, &b_norm, 1, MPI_LONG_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    b_norm = sqrtl(b_norm);
+
+    MPI_Request gather = MPI_REQUEST_NULL;
+    long double rel_residual = 0.0;
+    int cur = 0;
+    int iter = 0;
+
+    while (iter < max_iter) {
+        const long double* xc = x_full[cur];
+        size_t lo = rb->first, hi = rb->first + rb->count;
+
+        // диагональный блок по своей копии x, пока остальные блоки в пути
+        for (int i = 0; i < rb->count; i++) {
+            tmp[i] = -b[i];
+        }
+        matvec_columns(rb, A, x_own[cur], lo, tmp, lo, hi, threads, rb->funneled ? &gather : NULL);
+        MPI_Wait(&gather, MPI_STATUS_IGNORE);
+        matvec_columns(rb, A, xc, 0, tmp, 0, lo, threads, NULL);
+        matvec_columns(rb, A, xc, 0, tmp, hi, MATRIX_SIZE, threads, NULL);
+
+        long double local = local_sq_norm(tmp, rb->count, threads);
+        long double global = 0.0;
+        MPI_Request reduce;
+        MPI_Iallreduce(&local, &global, 1, MPI_LONG_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &reduce);
+
+        // обновление своего блока до того, как известна невязка
+        int next = 1 - cur;
+        par::parallel_for<par::OpenMP>(0, rb->count, threads, [&](size_t i) {
+            x_own[next][i] = x_own[cur][i] - ITERATION_STEP * tmp[i];
+        });
+
+        MPI_Wait(&reduce, MPI_STATUS_IGNORE);
+        rel_residual = sqrtl(global) / b_norm;
+        iter++;
+
+        if (rel_residual <= EPSILON) break;
+
+        MPI_Iallgatherv(x_own[next], rb->count, MPI_LONG_DOUBLE,
+                        x_full[next], rb->counts, rb->displs, MPI_LONG_DOUBLE,
+                        MPI_COMM_WORLD, &gather);
+        cur = next;
+    }
+
+    MPI_Wait(&gather, MPI_STATUS_IGNORE);
+    if (x_full[cur] != x) {
+        memcpy(x, x_full[cur], MATRIX_SIZE * sizeof(long double));
+    }
+
+    free(tmp);
+    free(x_own[0]); free(x_own[1]);
+    free(x_full[1]);
+    *residual = rel_residual;
+    return iter;
+}
+
+void check_solution(const row_block* rb, const long double* x) {
+    long double local = 0.0, error = 0.0;
+    for (int i = 0; i < rb->count; i++) {
+        local += fabsl(x[rb->first + i] - 1.0L);
+    }
+    MPI_Reduce(&local, &error, 1, MPI_LONG_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    if (rb->rank == 0) {
+        printf("Average error: %.3Le\n", error/MATRIX_SIZE);
+    }
+}
+
+int main(int argc, char** argv) {
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+
+    row_block rb = create_row_block(MPI_COMM_WORLD);
+    rb.funneled = provided >= MPI_THREAD_FUNNELED;
+    if (rb.rank == 0) {
+        print_system_info();
+        printf("\nRanks: %d\n", rb.nranks);
+        if (!rb.funneled) {
+            printf("MPI_THREAD_FUNNELED not provided: no MPI_Test polling in the matvec\n");
+        }
+    }
+
+    int threads[] = {1, 2, 4, 8, 16, 20};
+    int num_tests = sizeof(threads)/sizeof(threads[0]);
+
+    long double* A = create_vector((size_t)rb.count * MATRIX_SIZE);
+    long double* b = create_vector(rb.count);
+    long double* x = create_vector(MATRIX_SIZE);
+
+    initialize(&rb, A, b, threads[num_tests - 1]);
+
+    for (int i = 0; i < num_tests; i++) {
+        long double residual;
+        memset(x, 0, MATRIX_SIZE * sizeof(long double));
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        double start = MPI_Wtime();
+        int iter = solve_system(&rb, A, b, x, threads[i], MAX_ITER, &residual);
+        MPI_Barrier(MPI_COMM_WORLD);
+        double time = MPI_Wtime() - start;
+
+        if (rb.rank == 0) {
+            printf("\nThreads per rank: %d (total %d)\n", threads[i], threads[i] * rb.nranks);
+            printf("%d iterations, residual: %.3Le\n", iter, residual);
+            printf("Time: %.3f sec\n", time);
+        }
+        check_solution(&rb, x);
+    }
+
+    free(A); free(b); free(x);
+    free_row_block(&rb);
+    MPI_Finalize();
+    return 0;
+}
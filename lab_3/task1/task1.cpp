@@ -4,6 +4,7 @@
 #include <chrono>
 #include <thread>
 #include <iomanip>
+#include "parallel.hpp"
 
 using namespace std;
 using namespace chrono;
@@ -16,66 +17,36 @@ double measure_time(Func func) {
     return duration_cast<duration<double>>(end - start).count();
 }
 
-template<typename Container>
+template<typename Backend, typename Container>
 void initialize_parallel(Container& matrix, Container& vector, size_t size, size_t threads_num) {
-    auto init_part = [&](size_t start, size_t end) {
-        for (size_t i = start; i < end; ++i) {
-            for (size_t j = 0; j < size; ++j) {
-                matrix[i * size + j] = (i + j) % 100;
-            }
-            vector[i] = i % 100;
+    par::parallel_for<Backend>(0, size, threads_num, [&](size_t i) {
+        for (size_t j = 0; j < size; ++j) {
+            matrix[i * size + j] = (i + j) % 100;
         }
-    };
-
-    std::vector<std::thread> threads;
-    size_t chunk_size = size / threads_num;
-    
-    for (size_t i = 0; i < threads_num; ++i) {
-        size_t start = i * chunk_size;
-        size_t end = (i == threads_num - 1) ? size : start + chunk_size;
-        threads.emplace_back(init_part, start, end);
-    }
-
-    for (auto& t : threads) {
-        t.join();
-    }
+        vector[i] = i % 100;
+    });
 }
 
-template<typename Container>
+template<typename Backend, typename Container>
 Container multiply_parallel(const Container& matrix, const Container& vector, 
                           size_t size, size_t threads_num) {
     Container result(size);
     
-    auto multiply_part = [&](size_t start, size_t end) {
-        for (size_t i = start; i < end; ++i) {
-            double sum = 0;
-            for (size_t j = 0; j < size; ++j) {
-                sum += matrix[i * size + j] * vector[j];
-            }
-            result[i] = sum;
+    par::parallel_for<Backend>(0, size, threads_num, [&](size_t i) {
+        double sum = 0;
+        for (size_t j = 0; j < size; ++j) {
+            sum += matrix[i * size + j] * vector[j];
         }
-    };
-
-    std::vector<std::thread> threads;
-    size_t chunk_size = size / threads_num;
-    
-    for (size_t i = 0; i < threads_num; ++i) {
-        size_t start = i * chunk_size;
-        size_t end = (i == threads_num - 1) ? size : start + chunk_size;
-        threads.emplace_back(multiply_part, start, end);
-    }
-
-    for (auto& t : threads) {
-        t.join();
-    }
+        result[i] = sum;
+    });
     
     return result;
 }
 
-template<typename Container>
+template<typename Container, typename Backend>
 void test_container(const string& container_name, size_t matrix_size, 
                    const vector<size_t>& threads_counts) {
-    cout << "Testing " << container_name << " with size " << matrix_size << "x" << matrix_size << endl;
+    cout << "Testing " << container_name << " (" << par::backend_name<Backend>() << ") with size " << matrix_size << "x" << matrix_size << endl;
     cout << "Threads\tInit Time (s)\tMult Time (s)\tTotal Time (s)\tSpeedup" << endl;
 
     double single_thread_time = 0;
@@ -86,11 +57,11 @@ void test_container(const string& container_name, size_t matrix_size,
         Container result;
 
         double init_time = measure_time([&]() {
-            initialize_parallel(matrix, vector, matrix_size, threads);
+            initialize_parallel<Backend>(matrix, vector, matrix_size, threads);
         });
 
         double mult_time = measure_time([&]() {
-            result = multiply_parallel(matrix, vector, matrix_size, threads);
+            result = multiply_parallel<Backend>(matrix, vector, matrix_size, threads);
         });
 
         double total_time = init_time + mult_time;
@@ -119,8 +90,12 @@ int main() {
         cout << " MATRIX SIZE: " << size << "x" << size << endl;
         cout << "=============================================" << endl;
         
-        test_container<vector<double>>("std::vector", size, threads_counts);
-        test_container<deque<double>>("std::deque", size, threads_counts);
+        test_container<vector<double>, par::ThreadPool>("std::vector", size, threads_counts);
+        test_container<vector<double>, par::OpenMP>("std::vector", size, threads_counts);
+        test_container<vector<double>, par::Serial>("std::vector", size, {1});
+        test_container<deque<double>, par::ThreadPool>("std::deque", size, threads_counts);
+        test_container<deque<double>, par::OpenMP>("std::deque", size, threads_counts);
+        test_container<deque<double>, par::Serial>("std::deque", size, {1});
     }
 
     return 0;
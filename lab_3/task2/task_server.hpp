@@ -0,0 +1,297 @@
+#ifndef TASK_SERVER_HPP
+#define TASK_SERVER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum class Operation { Sin, Sqrt, Pow };
+
+// типизированный запрос: чистое вычисление, которое можно кэшировать
+template<typename T>
+struct Request {
+    Operation op;
+    T arg0;
+    T arg1 = T();   // показатель степени для Pow
+
+    bool operator==(const Request&) const = default;
+
+    T evaluate() const {
+        switch (op) {
+            case Operation::Sin:  return std::sin(arg0);
+            case Operation::Sqrt: return std::sqrt(arg0);
+            case Operation::Pow:  return std::exp(std::log(arg0) * arg1);
+        }
+        throw std::invalid_argument("Unknown operation");
+    }
+};
+
+template<typename T>
+struct RequestHash {
+    size_t operator()(const Request<T>& r) const {
+        size_t h = std::hash<int>()(static_cast<int>(r.op));
+        for (T arg : {r.arg0, r.arg1}) {
+            h ^= std::hash<T>()(arg) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        }
+        return h;
+    }
+};
+
+struct CacheStats {
+    size_t hits = 0;        // готовый результат
+    size_t coalesced = 0;   // совпал с запросом, который ещё выполняется
+    size_t misses = 0;
+
+    double hit_rate() const {
+        size_t total = hits + coalesced + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits + coalesced) / total;
+    }
+};
+
+// Шардированный LRU-кэш результатов. Хранит shared_future, поэтому повторный
+// запрос, пришедший до завершения первого, получает тот же future и не
+// выполняется второй раз.
+template<typename T>
+class ResultCache {
+public:
+    using Key = Request<T>;
+
+    ResultCache(size_t capacity, size_t num_shards)
+        : shards_(num_shards),
+          shard_capacity_(std::max<size_t>(1, (capacity + num_shards - 1) / num_shards)) {}
+
+    // Возвращает future из кэша. При промахе под блокировкой шарда вставляет future
+    // нового promise и отдаёт promise в reserved - вызывающий обязан его выполнить.
+    // При попадании ничего не создаётся.
+    std::shared_future<T> get_or_reserve(const Key& key, std::optional<std::promise<T>>& reserved) {
+        Shard& shard = shards_[RequestHash<T>()(key) % shards_.size()];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            const std::shared_future<T>& cached = it->second->second;
+            if (cached.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                shard.stats.hits++;
+            } else {
+                shard.stats.coalesced++;
+            }
+            return cached;
+        }
+
+        shard.stats.misses++;
+        reserved.emplace();
+        std::shared_future<T> fresh = reserved->get_future().share();
+        shard.lru.emplace_front(key, fresh);
+        shard.index.emplace(key, shard.lru.begin());
+        if (shard.lru.size() > shard_capacity_) {
+            shard.index.erase(shard.lru.back().first);
+            shard.lru.pop_back();
+        }
+        return fresh;
+    }
+
+    CacheStats stats() const {
+        CacheStats total;
+        for (const Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total.hits += shard.stats.hits;
+            total.coalesced += shard.stats.coalesced;
+            total.misses += shard.stats.misses;
+        }
+        return total;
+    }
+
+private:
+    using LruList = std::list<std::pair<Key, std::shared_future<T>>>;
+    
+    struct Shard {
+        mutable std::mutex mutex;
+        LruList lru;
+        std::unordered_map<Key, typename LruList::iterator, RequestHash<T>> index;
+        CacheStats stats;
+    };
+
+    std::vector<Shard> shards_;
+    size_t shard_capacity_;
+};
+
+template<typename T>
+class TaskServer {
+public:
+    using TaskType = std::function<T()>;
+    
+    TaskServer() : running_(false) {}
+    
+    // cache_capacity > 0 включает кэш результатов для типизированных запросов
+    explicit TaskServer(size_t cache_capacity, size_t cache_shards = 16) : running_(false) {
+        if (cache_capacity > 0) {
+            cache_ = std::make_unique<ResultCache<T>>(cache_capacity, cache_shards);
+        }
+    }
+    
+    ~TaskServer() {
+        if (running_) {
+            stop();
+        }
+    }
+    
+    void start() {
+        running_ = true;
+        server_thread_ = std::jthread([this](std::stop_token stoken) {
+            this->run(stoken);
+        });
+    }
+    
+    void stop() {
+        if (!running_) return;
+        
+        // под mutex_, иначе сервер может проверить условие до request_stop
+        // и заснуть уже после notify_all
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+            server_thread_.request_stop();
+        }
+        cv_.notify_all();
+        if (server_thread_.joinable()) {
+            server_thread_.join();
+        }
+    }
+    
+    size_t add_task(TaskType task) {
+        std::packaged_task<T()> pt(task);
+        return enqueue(std::move(pt));
+    }
+    
+    // результат из кэша (или уже выполняющийся) возвращается без постановки в очередь;
+    // задача создаётся только при промахе
+    size_t add_task(const Request<T>& request) {
+        if (!cache_) {
+            return enqueue(std::packaged_task<T()>([request]() {
+                return request.evaluate();
+            }));
+        }
+        
+        std::optional<std::promise<T>> reserved;
+        std::shared_future<T> future = cache_->get_or_reserve(request, reserved);
+        if (reserved) {
+            std::packaged_task<T()> pt([request, promise = std::move(*reserved)]() mutable {
+                try {
+                    T value = request.evaluate();
+                    promise.set_value(value);
+                    return value;
+                } catch (...) {
+                    promise.set_exception(std::current_exception());
+                    throw;
+                }
+            });
+            return enqueue(std::move(pt), future);
+        }
+        
+        std::lock_guard<std::mutex> lock(futures_mutex_);
+        size_t id = next_id_++;
+        futures_[id] = future;
+        return id;
+    }
+    
+    CacheStats cache_stats() const {
+        return cache_ ? cache_->stats() : CacheStats();
+    }
+    
+    // число задач в очереди, ещё не взятых сервером
+    size_t queued() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size();
+    }
+    
+    T request_result(size_t id) {
+        std::shared_future<T> future;
+        {
+            std::lock_guard<std::mutex> lock(futures_mutex_);
+            auto it = futures_.find(id);
+            if (it == futures_.end()) {
+                throw std::runtime_error("Task id not found");
+            }
+            future = std::move(it->second);
+            futures_.erase(it);
+        }
+        
+        return future.get();
+    }
+    
+private:
+    size_t enqueue(std::packaged_task<T()> pt) {
+        std::shared_future<T> future = pt.get_future().share();
+        return enqueue(std::move(pt), future);
+    }
+    
+    size_t enqueue(std::packaged_task<T()> pt, const std::shared_future<T>& future) {
+        size_t id;
+        {
+            std::lock_guard<std::mutex> futures_lock(futures_mutex_);
+            id = next_id_++;
+            futures_[id] = future;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace(std::move(pt));
+        }
+        
+        cv_.notify_one();
+        return id;
+    }
+    
+    void run(std::stop_token stoken) {
+        while (!stoken.stop_requested()) {
+            std::packaged_task<T()> task;
+            
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this, &stoken] {
+                    return !tasks_.empty() || stoken.stop_requested();
+                });
+                
+                if (stoken.stop_requested()) {
+                    break;
+                }
+                
+                if (!tasks_.empty()) {
+                    task = std::move(tasks_.front());
+                    tasks_.pop();
+                }
+            }
+            
+            if (task.valid()) {
+                task();
+            }
+        }
+    }
+    
+    std::jthread server_thread_;
+    std::queue<std::packaged_task<T()>> tasks_;
+    std::map<size_t, std::shared_future<T>> futures_;
+    std::unique_ptr<ResultCache<T>> cache_;
+    std::mutex mutex_;
+    std::mutex futures_mutex_;
+    std::condition_variable cv_;
+    size_t next_id_ = 0;   // под futures_mutex_
+    bool running_;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include <stdexcept>
+#include <latch>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "task_server.hpp"
+
+const int CLIENTS = 8;
+const double RATE_EPSILON = 1e-12;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        throw std::runtime_error(message);
+    }
+}
+
+void check_stats(const CacheStats& stats, size_t hits, size_t coalesced, size_t misses) {
+    std::ostringstream oss;
+    oss << "expected " << hits << " hits, " << coalesced << " coalesced, " << misses
+        << " misses; got " << stats.hits << ", " << stats.coalesced << ", " << stats.misses;
+    check(stats.hits == hits && stats.coalesced == coalesced && stats.misses == misses, oss.str());
+}
+
+// true при промахе; зарезервированный promise сразу выполняется значением value
+bool insert(ResultCache<double>& cache, const Request<double>& key, double value) {
+    std::optional<std::promise<double>> reserved;
+    cache.get_or_reserve(key, reserved);
+    if (reserved) {
+        reserved->set_value(value);
+    }
+    return reserved.has_value();
+}
+
+// одинаковые запросы от нескольких клиентов, пока первый ещё в очереди
+void test_coalescing() {
+    TaskServer<double> server(64, 4);
+    const Request<double> request{Operation::Sin, 0.5};
+
+    std::vector<size_t> ids(CLIENTS);
+    std::latch go(CLIENTS);
+    std::vector<std::thread> clients;
+    for (int c = 0; c < CLIENTS; c++) {
+        clients.emplace_back([&, c] {
+            go.arrive_and_wait();
+            ids[c] = server.add_task(request);
+        });
+    }
+    for (auto& t : clients) {
+        t.join();
+    }
+
+    // сервер не запущен: все запросы совпали с первым, вычисление одно
+    check(server.queued() == 1, "expected a single queued evaluation, got " +
+                                std::to_string(server.queued()));
+    check_stats(server.cache_stats(), 0, CLIENTS - 1, 1);
+
+    server.start();
+    for (size_t id : ids) {
+        check(server.request_result(id) == std::sin(0.5), "wrong coalesced result");
+    }
+
+    // результат готов - следующий запрос попадает в кэш
+    check(server.request_result(server.add_task(request)) == std::sin(0.5), "wrong cached result");
+    check(server.queued() == 0, "cache hit must not be queued");
+    CacheStats stats = server.cache_stats();
+    check_stats(stats, 1, CLIENTS - 1, 1);
+    check(std::abs(stats.hit_rate() - CLIENTS / (CLIENTS + 1.0)) < RATE_EPSILON, "wrong hit rate");
+    server.stop();
+
+    std::cout << "coalescing passed (" << CLIENTS << " clients, 1 evaluation)\n";
+}
+
+// вытесняется давно не использованный ключ
+void test_lru_eviction() {
+    const size_t capacity = 4;
+    ResultCache<double> cache(capacity, 1);
+    auto key = [](int i) { return Request<double>{Operation::Sqrt, static_cast<double>(i)}; };
+
+    for (int i = 0; i < static_cast<int>(capacity); i++) {
+        check(insert(cache, key(i), i), "new key must be inserted");
+    }
+    // key(0) становится самым свежим, вытесняться должен key(1)
+    check(!insert(cache, key(0), -1), "key 0 must be cached");
+    check(insert(cache, key(capacity), capacity), "new key must be inserted");
+
+    std::optional<std::promise<double>> reserved;
+    check(cache.get_or_reserve(key(0), reserved).get() == 0 && !reserved, "key 0 must survive eviction");
+    check(insert(cache, key(1), 1), "key 1 must be evicted");
+    check_stats(cache.stats(), 2, 0, capacity + 2);
+    check(std::abs(cache.stats().hit_rate() - 2.0 / (capacity + 4)) < RATE_EPSILON, "wrong hit rate");
+    check(CacheStats().hit_rate() == 0.0, "empty stats must have zero hit rate");
+
+    std::cout << "LRU eviction passed (capacity " << capacity << ")\n";
+}
+
+int main() {
+    try {
+        test_coalescing();
+        test_lru_eviction();
+
+        std::cout << "\nAll cache tests passed successfully!\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTEST FAILED:\n" << e.what() << "\n";
+        return 1;
+    }
+}